@@ -1,7 +1,11 @@
 #pragma once
 
+#include <SFML/Graphics/RenderTarget.hpp>
 #include <SFML/Graphics/RenderWindow.hpp>
+#include <SFML/System/Time.hpp>
 #include <vector>
+#include <algorithm>
+#include <chrono>
 #include <optional>
 #include <stdexcept>
 #include <string>
@@ -13,10 +17,20 @@
 #include "./utilities/ColorParser.hpp"
 #include "./utilities/LengthResolver.hpp"
 #include "./utilities/TransformParser.hpp"
+#include "./utilities/Trace.hpp"
 #include "./core/RuleParser.hpp"
 #include "./core/ContextBuilder.hpp"
 #include "./core/PropertyDispatcher.hpp"
 #include "./core/FlexLayout.hpp"
+#include "./core/GridLayout.hpp"
+#include "./core/AsyncLayout.hpp"
+#include "./core/Damage.hpp"
+#include "./core/DeferredStyles.hpp"
+#include "./core/ElementRegistry.hpp"
+#include "./core/LayoutQueue.hpp"
+#include "./core/PostQueue.hpp"
+#include "./core/StyleEngine.hpp"
+#include "./core/Variables.hpp"
 
 class CSS {
 public:
@@ -31,50 +45,311 @@ public:
     template<typename T>
     static void Style(T& element, const std::vector<std::string>& rules)
     {
+        CSS_TRACE_ZONE("CSS::Style");
         assertInitialised();
         Styleable self = adapters::AdapterFactory::make(element);
-        std::optional<Styleable> noParent;
-        auto ctx   = core::ContextBuilder::build(self, noParent, *s_window);
-        auto decls = core::RuleParser::parse(rules);
-        core::PropertyDispatcher::apply(ctx, decls);
+        if (core::DeferredStyles::enabled()) core::DeferredStyles::record(self, rules, std::nullopt, std::nullopt);
+        else core::StyleEngine::style(self, rules, std::nullopt, nullptr, *s_window);
     }
 
     // Overload 2: with parent, no children
     template<typename T>
     static void Style(T& element, const std::vector<std::string>& rules, Styleable parent)
     {
+        CSS_TRACE_ZONE("CSS::Style");
         assertInitialised();
         Styleable self = adapters::AdapterFactory::make(element);
-        std::optional<Styleable> optParent = parent;
-        auto ctx   = core::ContextBuilder::build(self, optParent, *s_window);
-        auto decls = core::RuleParser::parse(rules);
-        core::PropertyDispatcher::apply(ctx, decls);
+        if (core::DeferredStyles::enabled()) core::DeferredStyles::record(self, rules, parent, std::nullopt);
+        else core::StyleEngine::style(self, rules, parent, nullptr, *s_window);
     }
 
     // Overload 3: no parent, with children
     template<typename T>
     static void Style(T& element, const std::vector<std::string>& rules, StyleableList children)
     {
+        CSS_TRACE_ZONE("CSS::Style");
         assertInitialised();
         Styleable self = adapters::AdapterFactory::make(element);
-        std::optional<Styleable> noParent;
-        auto ctx   = core::ContextBuilder::build(self, noParent, *s_window);
-        auto decls = core::RuleParser::parse(rules);
-        core::PropertyDispatcher::apply(ctx, decls);
-        core::FlexLayout::apply(ctx, children);
+        if (core::DeferredStyles::enabled()) core::DeferredStyles::record(self, rules, std::nullopt, std::move(children));
+        else core::StyleEngine::style(self, rules, std::nullopt, &children, *s_window);
     }
 
     // Overload 4: with parent and children
     template<typename T>
     static void Style(T& element, const std::vector<std::string>& rules, Styleable parent, StyleableList children)
     {
+        CSS_TRACE_ZONE("CSS::Style");
         assertInitialised();
         Styleable self = adapters::AdapterFactory::make(element);
-        std::optional<Styleable> optParent = parent;
-        auto ctx   = core::ContextBuilder::build(self, optParent, *s_window);
-        auto decls = core::RuleParser::parse(rules);
-        core::PropertyDispatcher::apply(ctx, decls);
-        core::FlexLayout::apply(ctx, children);
+        if (core::DeferredStyles::enabled()) core::DeferredStyles::record(self, rules, parent, std::move(children));
+        else core::StyleEngine::style(self, rules, parent, &children, *s_window);
+    }
+
+    // ── Deferred styling ────────────────────────────────────────────────────
+    // While deferring, Style() only records the call. flush() — or the next
+    // drawAll()/drawRegion()/needsRedraw()/damage() — styles each recorded element once with all
+    // its rules merged and lays each container out once, however many
+    // times it was styled. Turning deferring off flushes.
+    static void deferLayout(bool on = true) {
+        if (!on) flush();
+        core::DeferredStyles::enable(on);
+    }
+
+    static void flush() {
+        if (!core::DeferredStyles::pending()) return;
+        CSS_TRACE_ZONE("CSS::flush");
+        assertInitialised();
+        core::DeferredStyles::flush(*s_window);
+    }
+
+    // Caches the next flush — the build that follows this call — in `path`,
+    // keyed by the rules, the element tree and the window size: when they
+    // match what the file holds, that flush copies the stored positions and
+    // sizes instead of laying out. Later flushes don't touch the file.
+    // Defers until that flush if deferring was off; an empty path turns the
+    // cache off.
+    static void useLayoutCache(const std::string& path) {
+        core::LayoutCache::use(path);
+        if (!path.empty()) core::DeferredStyles::deferOnce();
+    }
+
+    // ── Incremental layout ──────────────────────────────────────────────────
+    // queue() takes the same arguments as Style() but only records the call;
+    // layoutFor() runs recorded calls in order until `budget` is spent. Once
+    // finished, the result is the same as calling Style() directly. An
+    // element queued before it was ever styled isn't drawn until it is.
+    using LayoutProgress = core::LayoutQueue::Progress;
+
+    template<typename T>
+    static void queue(T& element, const std::vector<std::string>& rules) {
+        core::LayoutQueue::push({ wrap(element), rules, std::nullopt, std::nullopt });
+    }
+
+    template<typename T>
+    static void queue(T& element, const std::vector<std::string>& rules, Styleable parent) {
+        core::LayoutQueue::push({ wrap(element), rules, parent, std::nullopt });
+    }
+
+    template<typename T>
+    static void queue(T& element, const std::vector<std::string>& rules, StyleableList children) {
+        core::LayoutQueue::push({ wrap(element), rules, std::nullopt, std::move(children) });
+    }
+
+    template<typename T>
+    static void queue(T& element, const std::vector<std::string>& rules, Styleable parent, StyleableList children) {
+        core::LayoutQueue::push({ wrap(element), rules, parent, std::move(children) });
+    }
+
+    // Call once per frame while layoutProgress() isn't finished
+    static LayoutProgress layoutFor(sf::Time budget) {
+        CSS_TRACE_ZONE("CSS::layoutFor");
+        assertInitialised();
+        return core::LayoutQueue::run(std::chrono::microseconds(budget.asMicroseconds()), *s_window);
+    }
+
+    static LayoutProgress layoutProgress() {
+        return core::LayoutQueue::progress();
+    }
+
+    // ── Background layout ───────────────────────────────────────────────────
+    // submit() styles the container now and lays its children out on a
+    // background thread; applyLayout(), once per frame before drawing,
+    // copies the newest finished layout onto the elements and sends what
+    // was submitted since. Children styled for the first time aren't drawn
+    // until their layout was applied.
+    template<typename T>
+    static void submit(T& element, const std::vector<std::string>& rules, StyleableList children) {
+        CSS_TRACE_ZONE("CSS::submit");
+        assertInitialised();
+        core::AsyncLayout::submit(wrap(element), rules, std::nullopt, std::move(children), *s_window);
+    }
+
+    template<typename T>
+    static void submit(T& element, const std::vector<std::string>& rules, Styleable parent, StyleableList children) {
+        CSS_TRACE_ZONE("CSS::submit");
+        assertInitialised();
+        core::AsyncLayout::submit(wrap(element), rules, parent, std::move(children), *s_window);
+    }
+
+    // True when a finished layout was applied
+    static bool applyLayout() {
+        assertInitialised();
+        return core::AsyncLayout::pump(*s_window);
+    }
+
+    // Nothing submitted is waiting or being laid out
+    static bool layoutIdle() {
+        return core::AsyncLayout::idle();
+    }
+
+    // ── Posting from other threads ──────────────────────────────────────────
+    // post() may be called from any thread: it only parses the rule and
+    // queues it, lock-free. applyPosted(), on the render thread once per
+    // frame, applies what was posted — the last value per element and
+    // property. post() returns false when the rule doesn't parse or the
+    // queue is full (4096 pending changes).
+    template<typename T>
+    static bool post(T& element, const std::string& rule) {
+        return core::PostQueue::post(wrap(element), rule);
+    }
+
+    static std::size_t applyPosted() {
+        assertInitialised();
+        return core::PostQueue::drain(*s_window);
+    }
+
+    // ── Pseudo-class states ─────────────────────────────────────────────────
+    // Declared inside Style() rules as ":hover { background-color: #89b4fa }".
+    // Paint-only changes are applied directly; layout reruns only when a
+    // state changes geometry.
+    using State = contracts::ElementState;
+
+    template<typename T>
+    static void setState(T& element, State state, bool on = true) {
+        assertInitialised();
+        core::StyleEngine::setState(wrap(element)->native(), state, on, *s_window);
+    }
+
+    // Moves :hover to the topmost styled element under `point`
+    static void hover(sf::Vector2f point) {
+        assertInitialised();
+        core::StyleEngine::hover(point, *s_window);
+    }
+
+    // ── Custom properties ───────────────────────────────────────────────────
+    // Root definitions, visible to every element ("--name" may also be
+    // declared inside Style() rules, scoped to that element and its
+    // descendants). Only elements that reference the variable are touched,
+    // and layout reruns only if a geometry declaration resolves differently.
+    static void setVar(const std::string& name, const std::string& value) {
+        assertInitialised();
+        if (core::Variables::setRoot(name, value))
+            core::StyleEngine::refreshVariable(name, *s_window);
+    }
+
+    static std::optional<std::string> getVar(const std::string& name) {
+        return core::Variables::root(name);
+    }
+
+    // ── Paint order ─────────────────────────────────────────────────────────
+    // Draws every styled element back-to-front: z-index within stacking
+    // contexts, then first-styled order. The order is maintained as styles
+    // change, so drawing never sorts.
+    //
+    // Elements outside the target's view or their overflow: hidden clip are
+    // skipped; partially clipped ones are drawn through a scissored view.
+    static void drawAll(sf::RenderTarget& target,
+                        const sf::RenderStates& states = sf::RenderStates::Default) {
+        draw(target, std::nullopt, states);
+    }
+
+    // Draws only what overlaps `region` (world coordinates — one of
+    // damage()), scissored to it. Clear the region first.
+    static void drawRegion(sf::RenderTarget& target, const sf::FloatRect& region,
+                           const sf::RenderStates& states = sf::RenderStates::Default) {
+        draw(target, region, states);
+    }
+
+    // ── Damage ──────────────────────────────────────────────────────────────
+    // Changes made through the library (Style, states, variables, images,
+    // refresh) are tracked per element. Both draw calls above mark the
+    // current state as drawn.
+
+    // Whether anything changed since the last drawAll()/drawRegion()
+    static bool needsRedraw() {
+        flush();
+        return core::Damage::pending();
+    }
+
+    // What changed since then, in world coordinates: old and new areas of
+    // every changed element, merged into at most `maxRects` disjoint rects
+    static std::vector<sf::FloatRect> damage(std::size_t maxRects = core::Damage::kMaxRects) {
+        flush();
+        return core::Damage::collect(maxRects);
+    }
+
+    // ── Picking ─────────────────────────────────────────────────────────────
+    // Every styled element (and every child passed to Style) is indexed by
+    // its final bounds. Results honour rotation/scale and paint order.
+
+    // Topmost element under `point`; the handle is invalid if there is none.
+    // Compare with `hit->native() == &myShape` to find out which one it is.
+    static Styleable hitTest(sf::Vector2f point) {
+        return core::ElementRegistry::hitTest(point);
+    }
+
+    // Elements overlapping `area`, back-to-front
+    static StyleableList query(const sf::FloatRect& area) {
+        return core::ElementRegistry::query(area);
+    }
+
+    // Re-index an element that was moved or changed outside of Style();
+    // it is redrawn with the next damage
+    template<typename T>
+    static void refresh(T& element) {
+        Styleable el = wrap(element);
+        utilities::DirtySet::mark(el->native(), utilities::DirtySet::Paint);
+        core::ElementRegistry::track(el);
+    }
+
+    // Must be called before a styled SFML object is destroyed
+    template<typename T>
+    static void forget(T& element) {
+        const void* native = wrap(element)->native();
+        core::LayoutQueue::forget(native);
+        core::AsyncLayout::forget(native);
+        core::DeferredStyles::forget(native);
+        core::PostQueue::forget(native);
+        core::StyleEngine::forget(native);
+        core::Damage::forget(native);
+        core::ElementRegistry::forget(native);
+        core::FlexLayout::forget(native);
+        core::GridLayout::forget(native);
+        adapters::RoundedRect::forget(native);
+        adapters::Background::forget(native);
+        adapters::DropShadow::forget(native);
+        adapters::NinePatch::forget(native);
+        adapters::ImageAtlas::forget(native);
+        adapters::TextWrapper::forget(native);
+    }
+
+    // Writes zones and counters recorded since start-up (or the last
+    // resetTrace()) as Chrome trace-event JSON. Requires CSS_SFML_TRACE;
+    // returns false otherwise or if the file cannot be written.
+    static bool dumpTrace(const std::string& path) {
+        return utilities::Trace::dump(path);
+    }
+
+    static void resetTrace() {
+        utilities::Trace::reset();
+    }
+
+    // Registers a font file under a font-family name. The file is mapped and
+    // loaded on first use and shared by every text styled with that family.
+    static void registerFont(const std::string& family, const std::string& path) {
+        adapters::FontRegistry::add(family, path);
+    }
+
+    static std::vector<adapters::FontRegistry::FontUsage> fontUsage() {
+        return adapters::FontRegistry::usage();
+    }
+
+    // Packs and uploads background images decoded since the last call, for
+    // at most `budget` (at least one image per call), and re-applies only
+    // the elements that were waiting on them. Call once per frame; returns
+    // the number of images that finished.
+    static std::size_t pumpUploads(sf::Time budget = sf::milliseconds(2)) {
+        assertInitialised();
+        const auto ready = adapters::ImageAtlas::pump(std::chrono::microseconds(budget.asMicroseconds()));
+        for (const auto& image : ready)
+            for (const void* native : image.waiters)
+                core::StyleEngine::refreshImage(native, *s_window);
+        return ready.size();
+    }
+
+    // Packing report for background-image atlases
+    static adapters::ImageAtlas::Stats atlasStats() {
+        return adapters::ImageAtlas::stats();
     }
 
     static sf::Color parseColor(const std::string& value) {
@@ -89,6 +364,59 @@ public:
 private:
     inline static sf::RenderWindow* s_window = nullptr;
 
+    // drawAll / drawRegion: visible elements in paint order, each scissored
+    // to its clip rect and the region, then commits the damage
+    static void draw(sf::RenderTarget& target, const std::optional<sf::FloatRect>& region,
+                     const sf::RenderStates& states) {
+        flush();
+        const sf::View view = target.getView();
+        sf::FloatRect area{ view.getCenter() - view.getSize() / 2.f, view.getSize() };
+        if (region) {
+            const auto visible = area.findIntersection(*region);
+            if (!visible) { core::Damage::commit(); return; }
+            area = *visible;
+        }
+
+        std::optional<sf::FloatRect> scissor;      // clip currently set on the target
+        core::ElementRegistry::visitVisible(area, [&](const Styleable& el, const sf::FloatRect* clip) {
+            if (core::LayoutQueue::hidden(el->native()) || core::AsyncLayout::hidden(el->native())) return;
+            std::optional<sf::FloatRect> want = region;
+            if (clip) {
+                const auto both = region ? clip->findIntersection(*region) : std::optional<sf::FloatRect>(*clip);
+                want = both ? *both : sf::FloatRect{};
+            }
+            if (want != scissor) {
+                if (want) {
+                    sf::View clipped = view;
+                    clipped.setScissor(toScissor(*want, view));
+                    target.setView(clipped);
+                } else {
+                    target.setView(view);
+                }
+                scissor = want;
+            }
+            target.draw(el->drawable(), states);
+        });
+        if (scissor) target.setView(view);
+        core::Damage::commit();
+    }
+
+    // World-space rect → scissor rect (fraction of the render target).
+    // Ignores view rotation, like the culling rect.
+    static sf::FloatRect toScissor(const sf::FloatRect& r, const sf::View& view) {
+        const sf::Vector2f topLeft = view.getCenter() - view.getSize() / 2.f;
+        const sf::FloatRect vp = view.getViewport();
+        auto map = [&](sf::Vector2f p) {
+            return sf::Vector2f{
+                std::clamp(vp.position.x + (p.x - topLeft.x) / view.getSize().x * vp.size.x, 0.f, 1.f),
+                std::clamp(vp.position.y + (p.y - topLeft.y) / view.getSize().y * vp.size.y, 0.f, 1.f)
+            };
+        };
+        const sf::Vector2f a = map(r.position);
+        const sf::Vector2f b = map(r.position + r.size);
+        return { a, b - a };
+    }
+
     static void assertInitialised() {
         if (!s_window)
             throw std::runtime_error(
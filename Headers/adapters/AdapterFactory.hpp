@@ -1,5 +1,6 @@
 #pragma once
 #include "../contracts/Types.hpp"
+#include "../utilities/Trace.hpp"
 #include "RectAdapter.hpp"
 #include "CircleAdapter.hpp"
 #include "ConvexAdapter.hpp"
@@ -25,6 +26,9 @@ struct AdapterFactory {
     static contracts::Styleable make(T& element) {
         using U = std::remove_cv_t<std::remove_reference_t<T>>;
 
+        if constexpr (!std::is_same_v<U, contracts::Styleable>)
+            CSS_TRACE_COUNT(AdapterAllocations);
+
         if constexpr (std::is_same_v<U, contracts::Styleable>)
             return element;
 
@@ -0,0 +1,101 @@
+#pragma once
+#include "../contracts/Gradient.hpp"
+#include "../utilities/Trace.hpp"
+#include "GradientMesh.hpp"
+#include "RoundedRect.hpp"
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/RenderStates.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Shape.hpp>
+#include <algorithm>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace adapters {
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  Background
+//
+//  Background layers painted over a shape's fill color, drawn in place of
+//  the shape by CSS::drawAll (ShapeAdapterBase::drawable()):
+//
+//    shape (fill + outline, or its RoundedRect)  →  gradient mesh
+//
+//  The gradient covers the shape's own outline — its points, or the rounded
+//  outline when border-radius is set — so it follows circles and rounded
+//  corners. The mesh comes from GradientMesh's shared cache and is looked
+//  up again only when that outline changes (i.e. on resize).
+// ─────────────────────────────────────────────────────────────────────────────
+
+class Background final : public sf::Drawable {
+public:
+    static void setGradient(const sf::Shape& shape, const contracts::Gradient& gradient) {
+        auto& all = registry();
+        if (gradient.empty()) { all.erase(&shape); return; }
+        auto& slot = all[&shape];
+        if (!slot) slot = std::make_unique<Background>(shape);
+        if (slot->gradient_ != gradient) {
+            slot->gradient_ = gradient;
+            slot->mesh_.reset();
+        }
+    }
+
+    [[nodiscard]] static const Background* find(const void* native) {
+        auto& all = registry();
+        auto it = all.find(native);
+        return it != all.end() ? it->second.get() : nullptr;
+    }
+
+    static void forget(const void* native) { registry().erase(native); }
+
+    explicit Background(const sf::Shape& shape) : shape_(&shape) {}
+
+    [[nodiscard]] const contracts::Gradient& gradient() const { return gradient_; }
+
+protected:
+    void draw(sf::RenderTarget& target, sf::RenderStates states) const override {
+        const RoundedRect* rounded = RoundedRect::find(shape_);
+        if (rounded) target.draw(*rounded, states);
+        else         target.draw(*shape_, states);
+
+        refresh(rounded);
+        if (mesh_ && mesh_->getVertexCount()) {
+            states.transform *= shape_->getTransform();
+            target.draw(*mesh_, states);
+        }
+    }
+
+private:
+    void refresh(const RoundedRect* rounded) const {
+        outline_.clear();
+        if (rounded) {
+            outline_ = rounded->outline();
+        } else {
+            const std::size_t n = shape_->getPointCount();
+            outline_.reserve(n);
+            for (std::size_t i = 0; i < n; ++i) outline_.push_back(shape_->getPoint(i));
+        }
+        if (mesh_ && outline_ == clip_) return;
+
+        // The gradient box starts at the local origin, as the shape's does
+        sf::Vector2f size{ 0.f, 0.f };
+        for (const auto& p : outline_) size = { std::max(size.x, p.x), std::max(size.y, p.y) };
+
+        clip_.swap(outline_);
+        mesh_ = GradientMesh::mesh(gradient_, size, clip_);
+    }
+
+    static std::unordered_map<const void*, std::unique_ptr<Background>>& registry() {
+        static std::unordered_map<const void*, std::unique_ptr<Background>> r;
+        return r;
+    }
+
+    const sf::Shape*     shape_;
+    contracts::Gradient  gradient_;
+
+    mutable std::vector<sf::Vector2f>              clip_, outline_;
+    mutable std::shared_ptr<const sf::VertexArray> mesh_;
+};
+
+} // namespace adapters
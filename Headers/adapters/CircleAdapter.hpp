@@ -10,6 +10,8 @@ public:
 
     // width/height on a circle → radius = min(w,h) / 2
     void setSize(sf::Vector2f sz) override {
+        CSS_TRACE_COUNT(SfmlSetterCalls);
+        touch(Dirty::Geometry, shape_->getRadius(), std::min(sz.x, sz.y) / 2.f);
         shape_->setRadius(std::min(sz.x, sz.y) / 2.f);
     }
     sf::Vector2f getSize() const override {
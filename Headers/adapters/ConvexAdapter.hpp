@@ -12,8 +12,12 @@ public:
 
     void setSize(sf::Vector2f target) override {
         auto current = getSize();
-        if (current.x > 0.f && current.y > 0.f)
-            shape_->setScale({ target.x / current.x, target.y / current.y });
+        if (current.x > 0.f && current.y > 0.f) {
+            CSS_TRACE_COUNT(SfmlSetterCalls);
+            const sf::Vector2f scale{ target.x / current.x, target.y / current.y };
+            touch(Dirty::Geometry, shape_->getScale(), scale);
+            shape_->setScale(scale);
+        }
     }
 
     std::string typeName() const override { return "ConvexShape"; }
@@ -0,0 +1,261 @@
+#pragma once
+#include "../contracts/BoxShadow.hpp"
+#include "../utilities/ShadowBlur.hpp"
+#include "../utilities/Trace.hpp"
+#include "Background.hpp"
+#include "RoundedRect.hpp"
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/PrimitiveType.hpp>
+#include <SFML/Graphics/RenderStates.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Shape.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace adapters {
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  DropShadow
+//
+//  box-shadow for shapes: one textured quad drawn under the element, in
+//  place of the shape in CSS::drawAll (ShapeAdapterBase::drawable()):
+//
+//    shadow quad  →  shape (or its Background / RoundedRect)
+//
+//  The quad samples a white mask whose alpha is the blurred box coverage,
+//  tinted by the shadow color through the vertex color. Masks are built on
+//  the CPU (ShadowBlur) and cached by (box size, blur, spread, corner
+//  radii), so identical cards share one mask and one texture — styling 500
+//  cards blurs once. Changing only the offset or color reuses the mask.
+//
+//  Corners follow border-radius (circular, the smaller of the two radii of
+//  an elliptical corner); circles cast round shadows. bounds() is what the
+//  quad covers — culling and damage tracking use it (getVisualBounds()).
+// ─────────────────────────────────────────────────────────────────────────────
+
+class DropShadow final : public sf::Drawable {
+public:
+    // Largest mask built, in pixels; bigger shadows are skipped
+    static constexpr std::size_t kMaxMaskPixels = 4096u * 4096u;
+
+    struct Mask {
+        sf::Vector2u size;                              // texture size, px
+        sf::Vector2f offset;                            // top-left relative to the box
+        mutable sf::Image                    image;     // released after upload
+        mutable std::unique_ptr<sf::Texture> texture;
+
+        // GPU texture, uploaded on first use
+        const sf::Texture* upload() const {
+            if (!texture) {
+                auto tex = std::make_unique<sf::Texture>();
+                if (!tex->loadFromImage(image)) return nullptr;
+                tex->setSmooth(true);
+                texture = std::move(tex);
+                image   = sf::Image();
+            }
+            return texture.get();
+        }
+    };
+
+    // ── Per-element registry ──────────────────────────────────────────────
+    // `round`: the shape is a circle — its box has fully rounded corners
+    static void set(const sf::Shape& shape, const contracts::BoxShadow& shadow, bool round = false) {
+        auto& all = registry();
+        if (shadow.empty()) { all.erase(&shape); return; }
+        auto& slot = all[&shape];
+        if (!slot) slot = std::make_unique<DropShadow>(shape, round);
+        slot->shadow_ = shadow;
+    }
+
+    [[nodiscard]] static const DropShadow* find(const void* native) {
+        auto& all = registry();
+        auto it = all.find(native);
+        return it != all.end() ? it->second.get() : nullptr;
+    }
+
+    static void forget(const void* native) { registry().erase(native); }
+
+    DropShadow(const sf::Shape& shape, bool round) : shape_(&shape), round_(round) {}
+
+    [[nodiscard]] const contracts::BoxShadow& shadow() const { return shadow_; }
+
+    // Local rect the shadow quad covers (same extent as its mask)
+    [[nodiscard]] sf::FloatRect bounds() const {
+        const sf::FloatRect box = shape_->getLocalBounds();
+        const float pad = static_cast<float>(utilities::ShadowBlur::reach(std::max(0.f, shadow_.blur) / 2.f) + 1);
+        const sf::Vector2f grown{ std::max(0.f, box.size.x + 2.f * shadow_.spread),
+                                  std::max(0.f, box.size.y + 2.f * shadow_.spread) };
+        return { { box.position.x + shadow_.x - shadow_.spread - pad, box.position.y + shadow_.y - shadow_.spread - pad },
+                 { std::ceil(grown.x) + 2.f * pad, std::ceil(grown.y) + 2.f * pad } };
+    }
+
+    // ── Shared masks ──────────────────────────────────────────────────────
+    // Mask for a box of `size` with per-corner radii in CSS order, px
+    static std::shared_ptr<const Mask> mask(sf::Vector2f size, float blur, float spread,
+                                            const std::array<float, 4>& radii) {
+        Key key{ { size.x, size.y, blur, spread, radii[0], radii[1], radii[2], radii[3] } };
+        auto& cache = masks();
+        auto it = cache.find(key);
+        if (it != cache.end()) return it->second;
+
+        if (cache.size() >= kCapacity) {
+            for (auto e = cache.begin(); e != cache.end();)
+                e = e->second.use_count() == 1 ? cache.erase(e) : std::next(e);
+            if (cache.size() >= kCapacity) cache.clear();
+        }
+        auto built = build(size, blur, spread, radii);
+        if (built) cache.emplace(key, built);
+        return built;
+    }
+
+    [[nodiscard]] static std::size_t cachedMasks() { return masks().size(); }
+
+protected:
+    void draw(sf::RenderTarget& target, sf::RenderStates states) const override {
+        refresh();
+        if (mask_) {
+            if (const sf::Texture* texture = mask_->upload()) {
+                sf::RenderStates shadow = states;
+                shadow.transform *= shape_->getTransform();
+                shadow.texture    = texture;
+                target.draw(quad_.data(), quad_.size(), sf::PrimitiveType::TriangleStrip, shadow);
+            }
+        }
+        if (const Background* background = Background::find(shape_))   target.draw(*background, states);
+        else if (const RoundedRect* rounded = RoundedRect::find(shape_)) target.draw(*rounded, states);
+        else                                                              target.draw(*shape_, states);
+    }
+
+private:
+    // Looks the mask up again only when the box or the shadow changed
+    void refresh() const {
+        const sf::FloatRect box = shape_->getLocalBounds();
+        const float thickness   = std::max(0.f, shape_->getOutlineThickness());
+
+        std::array<float, 4> radii{};
+        if (round_) {
+            radii.fill(std::min(box.size.x, box.size.y) / 2.f);
+        } else if (const RoundedRect* rounded = RoundedRect::find(shape_)) {
+            // Resolved against the rectangle itself; the outline grows them
+            const sf::Vector2f inner{ box.size.x - 2.f * thickness, box.size.y - 2.f * thickness };
+            std::array<float, 4> rx{}, ry{};
+            RoundedRect::resolve(rounded->radius(), inner, rx, ry);
+            for (int i = 0; i < 4; ++i) {
+                const float r = std::min(rx[i], ry[i]);
+                radii[i] = r > 0.f ? r + thickness : 0.f;
+            }
+        }
+
+        if (mask_ && box == box_ && radii == radii_ && shadow_ == built_) return;
+        box_   = box;
+        radii_ = radii;
+        built_ = shadow_;
+
+        mask_ = mask(box.size, shadow_.blur, shadow_.spread, radii);
+        if (!mask_) return;
+
+        const sf::Vector2f p{ box.position.x + mask_->offset.x + shadow_.x,
+                              box.position.y + mask_->offset.y + shadow_.y };
+        const sf::Vector2f s{ static_cast<float>(mask_->size.x), static_cast<float>(mask_->size.y) };
+        quad_ = { sf::Vertex{ p,                   shadow_.color, { 0.f, 0.f } },
+                  sf::Vertex{ { p.x + s.x, p.y },  shadow_.color, { s.x, 0.f } },
+                  sf::Vertex{ { p.x, p.y + s.y },  shadow_.color, { 0.f, s.y } },
+                  sf::Vertex{ p + s,               shadow_.color, s } };
+    }
+
+    // Rasterizes the spread box with anti-aliased rounded corners, padded
+    // by the blur's reach, then blurs it
+    static std::shared_ptr<const Mask> build(sf::Vector2f size, float blur, float spread,
+                                             const std::array<float, 4>& radii) {
+        CSS_TRACE_ZONE("DropShadow::buildMask");
+        const float sigma = std::max(0.f, blur) / 2.f;
+        const int   pad   = utilities::ShadowBlur::reach(sigma) + 1;
+        const sf::Vector2f box{ std::max(0.f, size.x + 2.f * spread), std::max(0.f, size.y + 2.f * spread) };
+        const int w = static_cast<int>(std::ceil(box.x)) + 2 * pad;
+        const int h = static_cast<int>(std::ceil(box.y)) + 2 * pad;
+        if (static_cast<std::size_t>(w) * static_cast<std::size_t>(h) > kMaxMaskPixels) return nullptr;
+
+        // Spread grows rounded corners with the box; square ones stay square
+        std::array<float, 4> r{};
+        const float limit = std::min(box.x, box.y) / 2.f;
+        for (int i = 0; i < 4; ++i) r[i] = radii[i] > 0.f ? std::clamp(radii[i] + spread, 0.f, limit) : 0.f;
+
+        // Coverage from the signed distance to the rounded box, per pixel center
+        std::vector<float> plane(static_cast<std::size_t>(w) * static_cast<std::size_t>(h));
+        const sf::Vector2f half{ box.x / 2.f, box.y / 2.f };
+        for (int y = 0; y < h; ++y) {
+            const float py = static_cast<float>(y - pad) + 0.5f - half.y;
+            for (int x = 0; x < w; ++x) {
+                const float px = static_cast<float>(x - pad) + 0.5f - half.x;
+                const float rc = px < 0.f ? (py < 0.f ? r[0] : r[3]) : (py < 0.f ? r[1] : r[2]);
+                const float qx = std::abs(px) - half.x + rc;
+                const float qy = std::abs(py) - half.y + rc;
+                const float d  = std::min(std::max(qx, qy), 0.f)
+                               + std::hypot(std::max(qx, 0.f), std::max(qy, 0.f)) - rc;
+                plane[static_cast<std::size_t>(y) * w + x] = std::clamp(0.5f - d, 0.f, 1.f);
+            }
+        }
+        utilities::ShadowBlur::blur(plane, w, h, sigma);
+
+        std::vector<std::uint8_t> rgba(plane.size() * 4, 255);
+        for (std::size_t i = 0; i < plane.size(); ++i)
+            rgba[i * 4 + 3] = static_cast<std::uint8_t>(std::clamp(plane[i], 0.f, 1.f) * 255.f + 0.5f);
+
+        auto m = std::make_shared<Mask>();
+        m->size   = { static_cast<unsigned>(w), static_cast<unsigned>(h) };
+        m->offset = { -spread - static_cast<float>(pad), -spread - static_cast<float>(pad) };
+        m->image.resize(m->size, rgba.data());
+        return m;
+    }
+
+    // ── Cache ─────────────────────────────────────────────────────────────
+    static constexpr std::size_t kCapacity = 128;
+
+    struct Key {
+        std::array<float, 8> f;     // size.x, size.y, blur, spread, radii[4]
+        bool operator==(const Key& o) const { return f == o.f; }
+    };
+    struct KeyHash {
+        std::size_t operator()(const Key& k) const {
+            std::uint64_t h = 0xcbf29ce484222325ull;
+            for (float v : k.f) {
+                std::uint32_t bits;
+                std::memcpy(&bits, &v, sizeof bits);
+                h ^= bits;
+                h *= 0x100000001b3ull;
+            }
+            return static_cast<std::size_t>(h);
+        }
+    };
+
+    static std::unordered_map<Key, std::shared_ptr<const Mask>, KeyHash>& masks() {
+        static std::unordered_map<Key, std::shared_ptr<const Mask>, KeyHash> m;
+        return m;
+    }
+
+    static std::unordered_map<const void*, std::unique_ptr<DropShadow>>& registry() {
+        static std::unordered_map<const void*, std::unique_ptr<DropShadow>> r;
+        return r;
+    }
+
+    const sf::Shape*       shape_;
+    bool                   round_;
+    contracts::BoxShadow   shadow_;
+
+    mutable std::shared_ptr<const Mask> mask_;
+    mutable std::array<sf::Vertex, 4>   quad_{};
+    mutable sf::FloatRect               box_;
+    mutable std::array<float, 4>        radii_{};
+    mutable contracts::BoxShadow        built_;
+};
+
+} // namespace adapters
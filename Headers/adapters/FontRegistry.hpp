@@ -0,0 +1,162 @@
+#pragma once
+#include "../utilities/MappedFile.hpp"
+#include "../utilities/StringUtils.hpp"
+#include <SFML/Graphics/Font.hpp>
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace adapters {
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  FontRegistry
+//
+//  Maps font-family names to font files and owns one shared sf::Font per
+//  file. Registering is cheap: nothing is read until a text is first styled
+//  with that family. Files are memory-mapped and handed to
+//  sf::Font::openFromMemory, so the mapping lives as long as the font.
+//
+//  Usage:
+//    CSS::registerFont("Inter",      "assets/Inter-Regular.ttf");
+//    CSS::registerFont("sans-serif", "assets/NotoSans-Regular.ttf");
+//    CSS::Style(label, { "font-family: \"Inter\", sans-serif" });
+//
+//  Family names are matched case-insensitively with quotes stripped; the
+//  first family in the list that registers and loads successfully wins.
+//  Registering several families to the same path shares a single font.
+//
+//  usage() reports one entry per file with every family registered to it:
+//  the mapped file, and the glyph-page textures sf::Font keeps for each
+//  character size texts were given with that font (see noteSize()).
+// ─────────────────────────────────────────────────────────────────────────────
+
+struct FontRegistry {
+
+    struct FontUsage {
+        std::string              path;
+        std::vector<std::string> families;          // normalised, sorted
+        std::vector<unsigned>    characterSizes;    // sizes texts used, sorted
+        std::size_t              fileBytes  = 0;    // mapped (or buffered) font file
+        std::size_t              glyphBytes = 0;    // RGBA glyph pages of those sizes
+        bool                     loaded     = false;
+        bool                     mapped     = false;
+    };
+
+    static void add(const std::string& family, const std::string& path) {
+        auto& r = registry();
+        auto fit = r.files.find(path);
+        if (fit == r.files.end())
+            fit = r.files.emplace(path, std::make_shared<Entry>()).first;
+        fit->second->path = path;
+        r.families[normalise(family)] = fit->second;
+    }
+
+    // Resolves a font-family list ("\"Inter\", sans-serif") to a loaded font,
+    // or nullptr if none of the families is registered and loadable.
+    static const sf::Font* resolve(const std::string& familyList) {
+        for (const auto& name : splitFamilies(familyList)) {
+            auto it = registry().families.find(name);
+            if (it == registry().families.end()) continue;
+            if (const sf::Font* f = load(*it->second)) return f;
+        }
+        return nullptr;
+    }
+
+    // A text was given `font` at `characterSize`; sf::Font builds a glyph
+    // page per size, which usage() accounts for. Fonts not loaded here are
+    // ignored.
+    static void noteSize(const sf::Font& font, unsigned characterSize) {
+        if (characterSize == 0) return;
+        for (auto& [path, entry] : registry().files) {
+            if (entry->font.get() != &font) continue;
+            auto& sizes = entry->sizes;
+            const auto it = std::lower_bound(sizes.begin(), sizes.end(), characterSize);
+            if (it == sizes.end() || *it != characterSize) sizes.insert(it, characterSize);
+            return;
+        }
+    }
+
+    [[nodiscard]] static std::vector<FontUsage> usage() {
+        const auto& r = registry();
+        std::vector<FontUsage> out;
+        out.reserve(r.files.size());
+        for (const auto& [path, entry] : r.files) {
+            FontUsage u;
+            u.path      = path;
+            u.loaded    = entry->font != nullptr;
+            u.fileBytes = entry->file.size();
+            u.mapped    = entry->file.isMapped();
+            for (const auto& [family, e] : r.families)
+                if (e == entry) u.families.push_back(family);
+            std::sort(u.families.begin(), u.families.end());
+            if (u.loaded) {
+                u.characterSizes = entry->sizes;
+                for (unsigned size : entry->sizes) {
+                    const sf::Vector2u page = entry->font->getTexture(size).getSize();
+                    u.glyphBytes += std::size_t{ page.x } * page.y * 4;
+                }
+            }
+            out.push_back(std::move(u));
+        }
+        std::sort(out.begin(), out.end(),
+                  [](const FontUsage& a, const FontUsage& b) { return a.path < b.path; });
+        return out;
+    }
+
+private:
+    struct Entry {
+        std::string               path;
+        utilities::MappedFile     file;
+        std::unique_ptr<sf::Font> font;
+        std::vector<unsigned>     sizes;            // character sizes used, sorted
+        bool                      failed = false;
+    };
+
+    struct Registry {
+        std::unordered_map<std::string, std::shared_ptr<Entry>> families;  // by family
+        std::unordered_map<std::string, std::shared_ptr<Entry>> files;     // by path
+    };
+
+    static Registry& registry() {
+        static Registry r;
+        return r;
+    }
+
+    static const sf::Font* load(Entry& e) {
+        if (e.font)   return e.font.get();
+        if (e.failed) return nullptr;
+
+        auto font = std::make_unique<sf::Font>();
+        if (!e.file.open(e.path) || !font->openFromMemory(e.file.data(), e.file.size())) {
+            e.file.close();
+            e.failed = true;
+            return nullptr;
+        }
+        e.font = std::move(font);
+        return e.font.get();
+    }
+
+    static std::string normalise(const std::string& name) {
+        std::string s = utilities::StringUtils::trim(name);
+        if (s.size() >= 2 && (s.front() == '"' || s.front() == '\'') && s.back() == s.front())
+            s = s.substr(1, s.size() - 2);
+        return utilities::StringUtils::toLower(utilities::StringUtils::trim(s));
+    }
+
+    static std::vector<std::string> splitFamilies(const std::string& list) {
+        std::vector<std::string> out;
+        size_t start = 0;
+        while (start <= list.size()) {
+            size_t comma = list.find(',', start);
+            if (comma == std::string::npos) comma = list.size();
+            std::string name = normalise(list.substr(start, comma - start));
+            if (!name.empty()) out.push_back(std::move(name));
+            start = comma + 1;
+        }
+        return out;
+    }
+};
+
+} // namespace adapters
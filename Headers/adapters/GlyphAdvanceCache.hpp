@@ -0,0 +1,114 @@
+#pragma once
+#include <SFML/Graphics/Font.hpp>
+#include <SFML/Graphics/Text.hpp>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <unordered_map>
+
+namespace adapters {
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  GlyphAdvanceCache
+//
+//  Pen advances and kerning pairs per (font, character size, bold), so line
+//  breaking never has to build an sf::Text to measure a substring.
+//
+//  Mirrors the pen arithmetic of sf::Text:
+//    x += kerning(prev, cur)
+//    x += ' '  → whitespace + letterSpacing
+//         '\t' → (whitespace + letterSpacing) * 4
+//         else → glyph.advance + letterSpacing
+//  with letterSpacing = whitespace / 3 * (factor - 1).
+//
+//  ASCII advances live in a flat array; everything else in hash maps.
+// ─────────────────────────────────────────────────────────────────────────────
+
+struct GlyphAdvanceCache {
+
+    class Table {
+    public:
+        Table(const sf::Font& font, unsigned size, bool bold)
+            : font_(&font), size_(size), bold_(bold)
+        {
+            ascii_.fill(NAN);
+            whitespace_ = font.getGlyph(U' ', size, bold).advance;
+        }
+
+        // Advance of `cur` following `prev` (0 at line start), kerning included.
+        [[nodiscard]] float advance(char32_t prev, char32_t cur, float letterSpacingFactor) {
+            const float spacing = whitespace_ / 3.f * (letterSpacingFactor - 1.f);
+            float x = prev ? kerning(prev, cur) : 0.f;
+
+            if      (cur == U' ')  x += whitespace_ + spacing;
+            else if (cur == U'\t') x += (whitespace_ + spacing) * 4.f;
+            else                   x += glyph(cur) + spacing;
+            return x;
+        }
+
+    private:
+        float glyph(char32_t c) {
+            if (c < ascii_.size()) {
+                float& slot = ascii_[c];
+                if (std::isnan(slot)) slot = font_->getGlyph(c, size_, bold_).advance;
+                return slot;
+            }
+            auto it = other_.find(c);
+            if (it != other_.end()) return it->second;
+            return other_.emplace(c, font_->getGlyph(c, size_, bold_).advance).first->second;
+        }
+
+        float kerning(char32_t a, char32_t b) {
+            const std::uint64_t key = (static_cast<std::uint64_t>(a) << 32) | b;
+            auto it = kerning_.find(key);
+            if (it != kerning_.end()) return it->second;
+            return kerning_.emplace(key, font_->getKerning(a, b, size_, bold_)).first->second;
+        }
+
+        const sf::Font*                         font_;
+        unsigned                                size_;
+        bool                                    bold_;
+        float                                   whitespace_ = 0.f;
+        std::array<float, 128>                  ascii_;
+        std::unordered_map<char32_t, float>     other_;
+        std::unordered_map<std::uint64_t, float> kerning_;
+    };
+
+    static Table& table(const sf::Font& font, unsigned size, std::uint32_t style) {
+        const bool bold = (style & sf::Text::Style::Bold) != 0;
+        const Key  key{ &font, size, bold };
+
+        auto& tables = entries();
+        auto it = tables.find(key);
+        if (it != tables.end()) return it->second;
+        return tables.emplace(key, Table(font, size, bold)).first->second;
+    }
+
+    // Call when a font that was measured is destroyed.
+    static void clear() { entries().clear(); }
+
+private:
+    struct Key {
+        const sf::Font* font;
+        unsigned        size;
+        bool            bold;
+        bool operator==(const Key& o) const {
+            return font == o.font && size == o.size && bold == o.bold;
+        }
+    };
+
+    struct KeyHash {
+        std::size_t operator()(const Key& k) const {
+            return std::hash<const void*>{}(k.font)
+                 ^ (static_cast<std::size_t>(k.size) << 1)
+                 ^ static_cast<std::size_t>(k.bold);
+        }
+    };
+
+    static std::unordered_map<Key, Table, KeyHash>& entries() {
+        static std::unordered_map<Key, Table, KeyHash> tables;
+        return tables;
+    }
+};
+
+} // namespace adapters
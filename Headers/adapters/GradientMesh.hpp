@@ -0,0 +1,353 @@
+#pragma once
+#include "../contracts/Gradient.hpp"
+#include "../utilities/Trace.hpp"
+#include <SFML/Graphics/PrimitiveType.hpp>
+#include <SFML/Graphics/VertexArray.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace adapters {
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  GradientMesh
+//
+//  Turns a contracts::Gradient into a vertex-colored triangle mesh covering
+//  an element's box (local coordinates), so a gradient costs one draw call
+//  and no texture.
+//
+//  Linear: t is affine in position, so the box is cut into one convex band
+//  per pair of stops (half-plane clipping). Inside a band the color is
+//  linear in t, which is exactly what GPU vertex interpolation does — the
+//  mesh is exact, not an approximation.
+//
+//  Radial: the box is covered by rings (one per stop, plus the far corner)
+//  × angular segments, each quad clipped to the box. Segment count follows
+//  the radius so the rings stay within kTolerance px of true circles.
+//
+//  Both accept an optional convex clip outline (e.g. RoundedRect corners)
+//  instead of the plain box. Meshes are cached by (gradient, size, clip) and
+//  shared between elements; sample() is the per-pixel reference the mesh
+//  vertex colors come from.
+// ─────────────────────────────────────────────────────────────────────────────
+
+struct GradientMesh {
+    static constexpr float kTolerance   = 0.35f;
+    static constexpr int   kMinSegments = 16;
+    static constexpr int   kMaxSegments = 256;
+
+    using Polygon = std::vector<sf::Vector2f>;
+
+    // Color of the gradient at local point p of a box of `size`
+    static sf::Color sample(const contracts::Gradient& g, sf::Vector2f size, sf::Vector2f p) {
+        const Frame f = frame(g, size);
+        return colorAt(f, f.t(p));
+    }
+
+    // Cached mesh; `clip` is a convex outline in local coordinates, empty → the box
+    static std::shared_ptr<const sf::VertexArray> mesh(
+        const contracts::Gradient& g, sf::Vector2f size, const Polygon& clip = {}
+    ) {
+        Key key{ g, size, clip };
+        auto& cache = meshes();
+        auto it = cache.find(key);
+        if (it != cache.end()) return it->second;
+
+        if (cache.size() >= kCapacity) {
+            for (auto e = cache.begin(); e != cache.end();)
+                e = e->second.use_count() == 1 ? cache.erase(e) : std::next(e);
+            if (cache.size() >= kCapacity) cache.clear();
+        }
+
+        auto built = std::make_shared<const sf::VertexArray>(build(g, size, clip));
+        cache.emplace(std::move(key), built);
+        return built;
+    }
+
+    // Uncached build — sf::PrimitiveType::Triangles
+    static sf::VertexArray build(const contracts::Gradient& g, sf::Vector2f size, const Polygon& clip = {}) {
+        CSS_TRACE_ZONE("GradientMesh::build");
+        sf::VertexArray out(sf::PrimitiveType::Triangles);
+        if (g.empty() || size.x <= 0.f || size.y <= 0.f) return out;
+
+        const Polygon area = clip.size() >= 3 ? clip
+                           : Polygon{ { 0.f, 0.f }, { size.x, 0.f }, { size.x, size.y }, { 0.f, size.y } };
+        const Frame f = frame(g, size);
+
+        if (g.kind == contracts::Gradient::Kind::Linear) linear(f, area, out);
+        else                                             radial(f, area, out);
+        return out;
+    }
+
+    [[nodiscard]] static std::size_t cachedMeshes() { return meshes().size(); }
+
+private:
+    struct Stop { float t; sf::Color color; };
+
+    // Everything needed to evaluate t and color for one (gradient, size)
+    struct Frame {
+        bool              radial = false;
+        sf::Vector2f      origin;           // linear: box center; radial: ellipse center
+        sf::Vector2f      axis;             // linear: direction / line length; radial: 1 / radii
+        std::vector<Stop> stops;            // resolved, non-decreasing t
+
+        [[nodiscard]] float t(sf::Vector2f p) const {
+            const sf::Vector2f d{ p.x - origin.x, p.y - origin.y };
+            if (!radial) return d.x * axis.x + d.y * axis.y + 0.5f;
+            const float x = d.x * axis.x, y = d.y * axis.y;
+            return std::sqrt(x * x + y * y);
+        }
+    };
+
+    static Frame frame(const contracts::Gradient& g, sf::Vector2f size) {
+        using G = contracts::Gradient;
+        Frame f;
+        float length = 1.f;     // gradient ray length in px, for px stops
+
+        if (g.kind == G::Kind::Linear) {
+            sf::Vector2f dir;
+            if (g.corner.x && g.corner.y) {
+                // Perpendicular to the diagonal between the two other corners
+                dir = { static_cast<float>(g.corner.x) * size.y, static_cast<float>(g.corner.y) * size.x };
+            } else {
+                const float a = g.angle * 0.017453292f;
+                dir = { std::sin(a), -std::cos(a) };
+            }
+            const float n = std::hypot(dir.x, dir.y);
+            dir = n > 0.f ? sf::Vector2f{ dir.x / n, dir.y / n } : sf::Vector2f{ 0.f, 1.f };
+            length = std::max(1e-3f, std::abs(size.x * dir.x) + std::abs(size.y * dir.y));
+            f.origin = { size.x / 2.f, size.y / 2.f };
+            f.axis   = { dir.x / length, dir.y / length };
+        } else {
+            f.radial = true;
+            const sf::Vector2f c{ g.center.x * size.x, g.center.y * size.y };
+            const float nearX = std::min(std::abs(c.x), std::abs(size.x - c.x));
+            const float nearY = std::min(std::abs(c.y), std::abs(size.y - c.y));
+            const float farX  = std::max(std::abs(c.x), std::abs(size.x - c.x));
+            const float farY  = std::max(std::abs(c.y), std::abs(size.y - c.y));
+            const bool  circle = g.shape == G::Shape::Circle;
+
+            sf::Vector2f r;
+            switch (g.extent) {
+                case G::Extent::ClosestSide:
+                    r = circle ? sf::Vector2f{ std::min(nearX, nearY), std::min(nearX, nearY) }
+                               : sf::Vector2f{ nearX, nearY };
+                    break;
+                case G::Extent::FarthestSide:
+                    r = circle ? sf::Vector2f{ std::max(farX, farY), std::max(farX, farY) }
+                               : sf::Vector2f{ farX, farY };
+                    break;
+                case G::Extent::ClosestCorner:
+                    r = circle ? sf::Vector2f{ std::hypot(nearX, nearY), std::hypot(nearX, nearY) }
+                               : sf::Vector2f{ nearX * 1.4142135f, nearY * 1.4142135f };
+                    break;
+                case G::Extent::FarthestCorner:
+                    r = circle ? sf::Vector2f{ std::hypot(farX, farY), std::hypot(farX, farY) }
+                               : sf::Vector2f{ farX * 1.4142135f, farY * 1.4142135f };
+                    break;
+            }
+            r = { std::max(r.x, 1e-3f), std::max(r.y, 1e-3f) };
+            length   = r.x;
+            f.origin = c;
+            f.axis   = { 1.f / r.x, 1.f / r.y };
+        }
+
+        f.stops = resolveStops(g.stops, length);
+        return f;
+    }
+
+    // CSS stop fix-up: first/last default to 0/1, unset ones spread evenly
+    // between their neighbours, and no stop may sit before an earlier one.
+    static std::vector<Stop> resolveStops(const std::vector<contracts::GradientStop>& in, float length) {
+        const std::size_t n = in.size();
+        std::vector<Stop>  out(n);
+        std::vector<bool>  set(n, false);
+        for (std::size_t i = 0; i < n; ++i) {
+            out[i].color = in[i].color;
+            if (in[i].hasPosition) {
+                out[i].t = in[i].pixels ? in[i].position / length : in[i].position;
+                set[i]   = true;
+            }
+        }
+        if (!set[0])     { out[0].t = 0.f;     set[0] = true; }
+        if (!set[n - 1]) { out[n - 1].t = 1.f; set[n - 1] = true; }
+
+        float highest = out[0].t;
+        for (std::size_t i = 1; i < n; ++i)
+            if (set[i]) { out[i].t = std::max(out[i].t, highest); highest = out[i].t; }
+
+        for (std::size_t i = 1; i < n;) {
+            if (set[i]) { ++i; continue; }
+            std::size_t j = i;
+            while (!set[j]) ++j;
+            const float a = out[i - 1].t, b = out[j].t;
+            for (std::size_t k = i; k < j; ++k)
+                out[k].t = a + (b - a) * static_cast<float>(k - i + 1) / static_cast<float>(j - i + 1);
+            i = j;
+        }
+        return out;
+    }
+
+    static sf::Color colorAt(const Frame& f, float t) {
+        const auto& s = f.stops;
+        if (t <= s.front().t) return s.front().color;
+        if (t >= s.back().t)  return s.back().color;
+        std::size_t i = 1;
+        while (s[i].t < t) ++i;
+        const float span = s[i].t - s[i - 1].t;
+        const float k = span > 0.f ? (t - s[i - 1].t) / span : 1.f;
+        auto mix = [k](std::uint8_t a, std::uint8_t b) {
+            return static_cast<std::uint8_t>(std::lround(a + (b - a) * k));
+        };
+        const sf::Color& a = s[i - 1].color;
+        const sf::Color& b = s[i].color;
+        return { mix(a.r, b.r), mix(a.g, b.g), mix(a.b, b.b), mix(a.a, b.a) };
+    }
+
+    // ── Linear ────────────────────────────────────────────────────────────
+    static void linear(const Frame& f, const Polygon& area, sf::VertexArray& out) {
+        std::vector<float> cuts;
+        for (const auto& s : f.stops)
+            if (cuts.empty() || s.t > cuts.back()) cuts.push_back(s.t);
+
+        Polygon band, tmp;
+        for (std::size_t i = 0; i <= cuts.size(); ++i) {
+            band = area;
+            if (i > 0)           clip(band, tmp, [&](sf::Vector2f p) { return f.t(p) - cuts[i - 1]; });
+            if (i < cuts.size()) clip(band, tmp, [&](sf::Vector2f p) { return cuts[i] - f.t(p); });
+            emit(f, band, out);
+        }
+    }
+
+    // ── Radial ────────────────────────────────────────────────────────────
+    static void radial(const Frame& f, const Polygon& area, sf::VertexArray& out) {
+        float reach = 0.f;
+        for (const auto& p : area) reach = std::max(reach, f.t(p));
+        if (reach <= 0.f) return;
+
+        const float rmax = std::max(1.f / f.axis.x, 1.f / f.axis.y) * reach;
+        const float step = rmax > kTolerance ? 2.f * std::acos(1.f - kTolerance / rmax) : 6.2831853f;
+        const int segments = std::clamp(static_cast<int>(std::ceil(6.2831853f / step)), kMinSegments, kMaxSegments);
+
+        // Chords sit inside the true circle, so the last ring reaches a bit
+        // further to cover the far corner
+        std::vector<float> rings{ 0.f };
+        for (const auto& s : f.stops)
+            if (s.t > rings.back() && s.t < reach) rings.push_back(s.t);
+        rings.push_back(reach / std::cos(3.1415927f / static_cast<float>(segments)));
+
+        const sf::Vector2f r{ 1.f / f.axis.x, 1.f / f.axis.y };
+        std::vector<sf::Vector2f> dirs(segments + 1);
+        for (int j = 0; j <= segments; ++j) {
+            const float a = 6.2831853f * static_cast<float>(j % segments) / static_cast<float>(segments);
+            dirs[j] = { std::cos(a) * r.x, std::sin(a) * r.y };
+        }
+        auto at = [&](float t, int j) { return sf::Vector2f{ f.origin.x + dirs[j].x * t, f.origin.y + dirs[j].y * t }; };
+
+        Polygon cell, tmp;
+        for (std::size_t i = 0; i + 1 < rings.size(); ++i) {
+            for (int j = 0; j < segments; ++j) {
+                cell.clear();
+                cell.push_back(rings[i] > 0.f ? at(rings[i], j) : f.origin);
+                cell.push_back(at(rings[i + 1], j));
+                cell.push_back(at(rings[i + 1], j + 1));
+                if (rings[i] > 0.f) cell.push_back(at(rings[i], j + 1));
+
+                clipConvex(cell, tmp, area);
+                emit(f, cell, out);
+            }
+        }
+    }
+
+    // ── Polygon helpers ───────────────────────────────────────────────────
+    // Sutherland–Hodgman against one half-plane: keeps points with side(p) >= 0
+    template<typename Side>
+    static void clip(Polygon& poly, Polygon& tmp, Side&& side) {
+        tmp.clear();
+        const std::size_t n = poly.size();
+        for (std::size_t i = 0; i < n; ++i) {
+            const sf::Vector2f a = poly[i], b = poly[(i + 1) % n];
+            const float sa = side(a), sb = side(b);
+            if (sa >= 0.f) tmp.push_back(a);
+            if ((sa >= 0.f) != (sb >= 0.f)) {
+                const float k = sa / (sa - sb);
+                tmp.push_back({ a.x + (b.x - a.x) * k, a.y + (b.y - a.y) * k });
+            }
+        }
+        poly.swap(tmp);
+    }
+
+    static void clipConvex(Polygon& poly, Polygon& tmp, const Polygon& area) {
+        // Orientation of `area` decides which side of each edge is inside
+        float twice = 0.f;
+        for (std::size_t i = 0; i < area.size(); ++i) {
+            const auto& a = area[i];
+            const auto& b = area[(i + 1) % area.size()];
+            twice += a.x * b.y - b.x * a.y;
+        }
+        const float sign = twice >= 0.f ? 1.f : -1.f;
+
+        for (std::size_t i = 0; i < area.size() && poly.size() >= 3; ++i) {
+            const sf::Vector2f a = area[i], b = area[(i + 1) % area.size()];
+            if (a == b) continue;
+            clip(poly, tmp, [&](sf::Vector2f p) {
+                return sign * ((b.x - a.x) * (p.y - a.y) - (b.y - a.y) * (p.x - a.x));
+            });
+        }
+    }
+
+    // Fan-triangulates a convex polygon, coloring each vertex from the gradient
+    static void emit(const Frame& f, const Polygon& poly, sf::VertexArray& out) {
+        if (poly.size() < 3) return;
+        const sf::Vertex root{ poly[0], colorAt(f, f.t(poly[0])), {} };
+        sf::Vertex prev{ poly[1], colorAt(f, f.t(poly[1])), {} };
+        for (std::size_t i = 2; i < poly.size(); ++i) {
+            const sf::Vertex next{ poly[i], colorAt(f, f.t(poly[i])), {} };
+            out.append(root);
+            out.append(prev);
+            out.append(next);
+            prev = next;
+        }
+    }
+
+    // ── Cache ─────────────────────────────────────────────────────────────
+    static constexpr std::size_t kCapacity = 512;
+
+    struct Key {
+        contracts::Gradient gradient;
+        sf::Vector2f        size;
+        Polygon             clip;
+        bool operator==(const Key& o) const {
+            return size == o.size && gradient == o.gradient && clip == o.clip;
+        }
+    };
+    struct KeyHash {
+        std::size_t operator()(const Key& k) const {
+            std::uint64_t h = 0xcbf29ce484222325ull;
+            auto mix = [&h](float v) {
+                std::uint32_t b; std::memcpy(&b, &v, 4);
+                h ^= b; h *= 0x100000001b3ull;
+            };
+            mix(k.size.x); mix(k.size.y);
+            mix(k.gradient.angle); mix(k.gradient.center.x); mix(k.gradient.center.y);
+            mix(static_cast<float>(k.gradient.kind) + 4.f * static_cast<float>(k.gradient.extent));
+            for (const auto& s : k.gradient.stops) {
+                mix(s.position);
+                h ^= s.color.toInteger(); h *= 0x100000001b3ull;
+            }
+            mix(static_cast<float>(k.clip.size()));
+            return static_cast<std::size_t>(h);
+        }
+    };
+
+    static std::unordered_map<Key, std::shared_ptr<const sf::VertexArray>, KeyHash>& meshes() {
+        static std::unordered_map<Key, std::shared_ptr<const sf::VertexArray>, KeyHash> m;
+        return m;
+    }
+};
+
+} // namespace adapters
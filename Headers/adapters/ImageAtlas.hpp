@@ -0,0 +1,349 @@
+#pragma once
+#include "../utilities/MappedFile.hpp"
+#include "../utilities/SkylinePacker.hpp"
+#include "../utilities/Trace.hpp"
+#include "../utilities/WorkerPool.hpp"
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace adapters {
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  ImageAtlas
+//
+//  Image cache behind background-image. Each file is decoded once and, if
+//  small enough, packed into a shared kPageSize² page with SkylinePacker;
+//  elements then reference a sub-rect of the page texture, so a screen of
+//  icons draws from one or two textures instead of one per image. Images
+//  larger than kMaxPacked on either side get a page of their own.
+//
+//  Packing works on sf::Image only. Page textures are created or updated
+//  when first asked for (texture()), so add() / image() / stats() run
+//  without a GPU context.
+//
+//  Packed images get a kPadding gutter filled with their own edge pixels,
+//  so smoothing never samples a neighbour.
+//
+//  Styling never decodes on the calling thread: request() hands the file
+//  to a WorkerPool and returns nullopt until the image is in. The main
+//  thread calls pump() (CSS::pumpUploads) to pack and upload finished
+//  images within a time budget; it returns the elements that asked for
+//  each one so only those are revisited.
+// ─────────────────────────────────────────────────────────────────────────────
+
+struct ImageAtlas {
+    static constexpr unsigned kPageSize  = 1024;
+    static constexpr unsigned kMaxPacked = 256;
+    static constexpr unsigned kPadding   = 1;
+
+    struct Region {
+        std::size_t page = 0;
+        sf::IntRect rect;               // pixels within the page
+    };
+
+    struct Stats {
+        std::size_t   images      = 0;
+        std::size_t   pages       = 0;  // shared pages
+        std::size_t   dedicated   = 0;  // oversized images with their own page
+        std::uint64_t imagePixels = 0;  // packed image area, gutters excluded
+        std::uint64_t pagePixels  = 0;  // shared page area
+        double        efficiency  = 0.0;// imagePixels / pagePixels
+        double        packMillis  = 0.0;// total time spent packing + copying
+        std::size_t   uploads     = 0;  // texture creates + sub-rect updates
+        std::size_t   loading     = 0;  // decodes not yet pumped
+    };
+
+    // An image pump() packed (or failed to decode) and who was waiting for it
+    struct Ready {
+        std::string              path;
+        bool                     ok = false;
+        std::vector<const void*> waiters;
+    };
+
+    // Decodes `path` once and packs it; nullopt if the file can't be read
+    static std::optional<Region> acquire(const std::string& path) {
+        auto& a = atlas();
+        if (auto it = a.regions.find(path); it != a.regions.end()) return it->second;
+        if (a.failed.count(path)) return std::nullopt;
+
+        sf::Image image;
+        if (!decode(path, image)) {
+            a.failed.insert(path);
+            return std::nullopt;
+        }
+        return add(path, image);
+    }
+
+    // Region if `path` is already packed. Otherwise starts decoding it on
+    // the worker pool (once per path) and records `waiter` for pump().
+    static std::optional<Region> request(const std::string& path, const void* waiter = nullptr) {
+        auto& a = atlas();
+        if (auto it = a.regions.find(path); it != a.regions.end()) return it->second;
+        if (a.failed.count(path)) return std::nullopt;
+
+        if (waiter) {
+            auto& list = a.waiters[path];
+            if (std::find(list.begin(), list.end(), waiter) == list.end()) list.push_back(waiter);
+        }
+        if (a.loading.insert(path).second) {
+            Loader& l = loader();
+            l.pool.submit([path, &l] {
+                Decoded d;
+                d.path = path;
+                d.ok   = decode(path, d.image);
+                std::lock_guard<std::mutex> lock(l.mutex);
+                l.done.push_back(std::move(d));
+            });
+        }
+        return std::nullopt;
+    }
+
+    // Packs and uploads decoded images until `budget` is spent — always at
+    // least one, so a small budget still makes progress.
+    static std::vector<Ready> pump(std::chrono::microseconds budget) {
+        CSS_TRACE_ZONE("ImageAtlas::pump");
+        auto& a = atlas();
+        Loader& l = loader();
+        const auto start = std::chrono::steady_clock::now();
+
+        std::vector<Ready> out;
+        for (;;) {
+            if (!out.empty() && std::chrono::steady_clock::now() - start >= budget) break;
+
+            Decoded d;
+            {
+                std::lock_guard<std::mutex> lock(l.mutex);
+                if (l.done.empty()) break;
+                d = std::move(l.done.front());
+                l.done.pop_front();
+            }
+            a.loading.erase(d.path);
+
+            Ready r;
+            r.path = d.path;
+            if (d.ok) {
+                const auto region = add(d.path, d.image);
+                r.ok = region && texture(region->page) != nullptr;
+            }
+            if (!r.ok) a.failed.insert(d.path);
+
+            if (auto w = a.waiters.find(d.path); w != a.waiters.end()) {
+                r.waiters = std::move(w->second);
+                a.waiters.erase(w);
+            }
+            out.push_back(std::move(r));
+        }
+        return out;
+    }
+
+    // Stops reporting `waiter` (the element is going away)
+    static void forget(const void* waiter) {
+        for (auto& [path, list] : atlas().waiters)
+            list.erase(std::remove(list.begin(), list.end(), waiter), list.end());
+    }
+
+    // Packs an already decoded image under `key`. Re-adding a key returns
+    // the existing region.
+    static std::optional<Region> add(const std::string& key, const sf::Image& image) {
+        auto& a = atlas();
+        if (auto it = a.regions.find(key); it != a.regions.end()) return it->second;
+
+        const sf::Vector2u size = image.getSize();
+        if (size.x == 0 || size.y == 0) return std::nullopt;
+
+        CSS_TRACE_ZONE("ImageAtlas::add");
+        const auto start = std::chrono::steady_clock::now();
+
+        Region region;
+        if (size.x > kMaxPacked || size.y > kMaxPacked) {
+            auto page = std::make_unique<Page>();
+            page->image     = image;
+            page->dedicated = true;
+            region.page = a.pages.size();
+            region.rect = { { 0, 0 }, { static_cast<int>(size.x), static_cast<int>(size.y) } };
+            a.pages.push_back(std::move(page));
+        } else {
+            region = pack(image);
+        }
+
+        a.packMillis += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        a.regions.emplace(key, region);
+        return region;
+    }
+
+    [[nodiscard]] static std::optional<Region> find(const std::string& key) {
+        auto& a = atlas();
+        auto it = a.regions.find(key);
+        if (it == a.regions.end()) return std::nullopt;
+        return it->second;
+    }
+
+    // CPU copy of a page
+    [[nodiscard]] static const sf::Image& image(std::size_t page) { return atlas().pages.at(page)->image; }
+
+    [[nodiscard]] static std::size_t pageCount() { return atlas().pages.size(); }
+
+    // GPU texture of a page, uploading whatever was packed since the last call
+    static const sf::Texture* texture(std::size_t page) {
+        auto& a = atlas();
+        if (page >= a.pages.size()) return nullptr;
+        Page& p = *a.pages[page];
+
+        if (!p.texture) {
+            auto tex = std::make_unique<sf::Texture>();
+            if (!tex->loadFromImage(p.image)) return nullptr;
+            p.texture = std::move(tex);
+            p.dirty.clear();
+            ++a.uploads;
+            return p.texture.get();
+        }
+
+        std::vector<std::uint8_t> rows;
+        const std::uint8_t* pixels = p.image.getPixelsPtr();
+        const unsigned stride = p.image.getSize().x * 4;
+        for (const auto& r : p.dirty) {
+            const unsigned w = static_cast<unsigned>(r.size.x), h = static_cast<unsigned>(r.size.y);
+            rows.resize(static_cast<std::size_t>(w) * h * 4);
+            for (unsigned y = 0; y < h; ++y)
+                std::copy_n(pixels + (r.position.y + y) * stride + r.position.x * 4, w * 4, rows.data() + y * w * 4);
+            p.texture->update(rows.data(), { w, h },
+                              { static_cast<unsigned>(r.position.x), static_cast<unsigned>(r.position.y) });
+            ++a.uploads;
+        }
+        p.dirty.clear();
+        return p.texture.get();
+    }
+
+    [[nodiscard]] static Stats stats() {
+        const auto& a = atlas();
+        Stats s;
+        s.images     = a.regions.size();
+        s.packMillis = a.packMillis;
+        s.uploads    = a.uploads;
+        s.loading    = a.loading.size();
+        for (const auto& p : a.pages) {
+            if (p->dedicated) { ++s.dedicated; continue; }
+            ++s.pages;
+            s.imagePixels += p->imagePixels;
+            s.pagePixels  += static_cast<std::uint64_t>(kPageSize) * kPageSize;
+        }
+        s.efficiency = s.pagePixels ? static_cast<double>(s.imagePixels) / static_cast<double>(s.pagePixels) : 0.0;
+        return s;
+    }
+
+    // Drops every page and region — textures handed out become invalid.
+    // Decodes still running are packed by the next pump() as usual.
+    static void clear() { atlas() = {}; }
+
+private:
+    struct Page {
+        sf::Image                    image;
+        utilities::SkylinePacker     packer;
+        std::unique_ptr<sf::Texture> texture;
+        std::vector<sf::IntRect>     dirty;          // packed since last upload
+        std::uint64_t                imagePixels = 0;
+        bool                         dedicated   = false;
+    };
+
+    struct Atlas {
+        std::vector<std::unique_ptr<Page>>      pages;
+        std::unordered_map<std::string, Region> regions;
+        std::unordered_set<std::string>         failed;
+        std::unordered_set<std::string>         loading;     // submitted, not yet pumped
+        std::unordered_map<std::string, std::vector<const void*>> waiters;
+        double                                  packMillis = 0.0;
+        std::size_t                             uploads    = 0;
+    };
+
+    static Atlas& atlas() {
+        static Atlas a;
+        return a;
+    }
+
+    struct Decoded {
+        std::string path;
+        sf::Image   image;
+        bool        ok = false;
+    };
+
+    // Worker output; the pool is declared last so it joins before the
+    // queue it writes to is destroyed
+    struct Loader {
+        std::mutex            mutex;
+        std::deque<Decoded>   done;
+        utilities::WorkerPool pool;
+    };
+
+    static Loader& loader() {
+        static Loader l;
+        return l;
+    }
+
+    static bool decode(const std::string& path, sf::Image& out) {
+        CSS_TRACE_ZONE("ImageAtlas::decode");
+        utilities::MappedFile file;
+        return file.open(path) && out.loadFromMemory(file.data(), file.size());
+    }
+
+    // First shared page with room; a new page when none has any
+    static Region pack(const sf::Image& image) {
+        auto& a = atlas();
+        const sf::Vector2u size = image.getSize();
+        const unsigned w = size.x + 2 * kPadding, h = size.y + 2 * kPadding;
+
+        std::optional<sf::Vector2u> at;
+        std::size_t index = 0;
+        for (; index < a.pages.size() && !at; ++index)
+            if (!a.pages[index]->dedicated) at = a.pages[index]->packer.insert(w, h);
+        if (at) {
+            --index;
+        } else {
+            auto page = std::make_unique<Page>();
+            page->image.resize({ kPageSize, kPageSize }, sf::Color::Transparent);
+            page->packer.reset(kPageSize, kPageSize);
+            at    = page->packer.insert(w, h);
+            index = a.pages.size();
+            a.pages.push_back(std::move(page));
+        }
+
+        Page& page = *a.pages[index];
+        blit(page.image, image, { at->x + kPadding, at->y + kPadding });
+        page.dirty.push_back({ { static_cast<int>(at->x), static_cast<int>(at->y) },
+                               { static_cast<int>(w), static_cast<int>(h) } });
+        page.imagePixels += static_cast<std::uint64_t>(size.x) * size.y;
+
+        return { index, { { static_cast<int>(at->x + kPadding), static_cast<int>(at->y + kPadding) },
+                          { static_cast<int>(size.x), static_cast<int>(size.y) } } };
+    }
+
+    // Copies `src` to `dst` at `at`, then repeats its edge pixels into the gutter
+    static void blit(sf::Image& dst, const sf::Image& src, sf::Vector2u at) {
+        if (!dst.copy(src, at)) return;
+        const sf::Vector2u s = src.getSize();
+        for (unsigned g = 1; g <= kPadding; ++g) {
+            for (unsigned y = 0; y < s.y; ++y) {
+                dst.setPixel({ at.x - g,           at.y + y }, src.getPixel({ 0,       y }));
+                dst.setPixel({ at.x + s.x - 1 + g, at.y + y }, src.getPixel({ s.x - 1, y }));
+            }
+            for (unsigned x = 0; x < s.x + 2 * g; ++x) {
+                const unsigned px = at.x - g + x;
+                dst.setPixel({ px, at.y - g },           dst.getPixel({ px, at.y - g + 1 }));
+                dst.setPixel({ px, at.y + s.y - 1 + g }, dst.getPixel({ px, at.y + s.y - 2 + g }));
+            }
+        }
+    }
+};
+
+} // namespace adapters
@@ -0,0 +1,140 @@
+#pragma once
+#include "../contracts/IStyleable.hpp"
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <algorithm>
+#include <optional>
+#include <string>
+
+namespace adapters {
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  LayoutProxy
+//
+//  Stand-in for an element while a layout runs off the render thread: a
+//  copy of its geometry taken on the render thread — position, origin,
+//  scale, rotation and local bounds, so getTransform() and global bounds
+//  match the element's — with the element's identity (native()) but no
+//  SFML object behind it. Layouts read and move the copy; the render
+//  thread copies the result back onto the element.
+//
+//  setSize() is recorded for the render thread to replay (requested()) and
+//  changes the reported geometry the way the real adapter would:
+//    Exact    rectangles, nine-sliced sprites — size and bounds become the
+//             requested size (bounds keep their outline margin)
+//    Square   circles — the smaller side, both ways
+//    Scale    sprites — scaled to the requested size, which they report
+//    Stretch  convex shapes — scaled, which their reported size ignores
+//    Fixed    texts (the width wraps them once applied) — unchanged
+//
+//  Paint setters are ignored: layouts only position and size.
+// ─────────────────────────────────────────────────────────────────────────────
+
+class LayoutProxy final : public contracts::IStyleable {
+public:
+    enum class Resize { Exact, Square, Scale, Stretch, Fixed };
+
+    explicit LayoutProxy(const contracts::IStyleable& of)
+        : native_(of.native()), position_(of.getPosition()), size_(of.getSize()),
+          bounds_(of.getBounds()), origin_(of.getOrigin()), scale_(of.getScale()),
+          rotation_(of.getRotation()), resize_(resizeOf(of)) {}
+
+    static Resize resizeOf(const contracts::IStyleable& el) {
+        if (el.isText())                      return Resize::Fixed;
+        if (el.typeName() == "CircleShape")   return Resize::Square;
+        if (el.typeName() == "ConvexShape")   return Resize::Stretch;
+        if (el.isSprite())                    return el.getNineSlice().empty() ? Resize::Scale : Resize::Exact;
+        return Resize::Exact;
+    }
+
+    // ── Geometry queries ───────────────────────────────────────────────────
+    sf::Vector2f  getPosition() const override { return position_; }
+    sf::Vector2f  getSize()     const override { return size_; }
+    sf::FloatRect getBounds()   const override { return bounds_; }
+    sf::Vector2f  getOrigin()   const override { return origin_; }
+    sf::Vector2f  getScale()    const override { return scale_; }
+    float         getRotation() const override { return rotation_; }
+
+    // As sf::Transformable composes it
+    sf::Transform getTransform() const override {
+        sf::Transform t;
+        t.translate(position_);
+        t.rotate(sf::degrees(rotation_));
+        t.scale(scale_);
+        t.translate(-origin_);
+        return t;
+    }
+
+    // ── Geometry mutations ─────────────────────────────────────────────────
+    void setPosition(sf::Vector2f p) override { position_ = p; }
+    void move       (sf::Vector2f d) override { position_ += d; }
+    void setOrigin  (sf::Vector2f o) override { origin_ = o; }
+    void setScale   (sf::Vector2f s) override { scale_ = s; }
+    void setRotation(float degrees)  override { rotation_ = degrees; }
+
+    void setSize(sf::Vector2f sz) override {
+        requested_ = sz;
+        switch (resize_) {
+            case Resize::Exact:
+                resize(sz);
+                break;
+            case Resize::Square: {
+                const float side = std::min(sz.x, sz.y);
+                resize({ side, side });
+                break;
+            }
+            case Resize::Scale:
+                if (bounds_.size.x > 0.f && bounds_.size.y > 0.f) {
+                    scale_ = { sz.x / bounds_.size.x, sz.y / bounds_.size.y };
+                    size_  = sz;
+                }
+                break;
+            case Resize::Stretch:
+                if (size_.x > 0.f && size_.y > 0.f) scale_ = { sz.x / size_.x, sz.y / size_.y };
+                break;
+            case Resize::Fixed:
+                break;
+        }
+    }
+
+    // ── Paint (ignored) ────────────────────────────────────────────────────
+    void      setFillColor       (sf::Color) override {}
+    void      setOutlineColor    (sf::Color) override {}
+    void      setOutlineThickness(float)     override {}
+    sf::Color getFillColor()           const override { return sf::Color::Transparent; }
+
+    // Last size a layout asked for, if any
+    [[nodiscard]] const std::optional<sf::Vector2f>& requested() const { return requested_; }
+
+    std::string typeName() const override { return "LayoutProxy"; }
+    const void* native()   const override { return native_; }
+
+    const sf::Drawable& drawable() const override {
+        static const Inert inert;
+        return inert;
+    }
+
+private:
+    struct Inert final : sf::Drawable {
+    protected:
+        void draw(sf::RenderTarget&, sf::RenderStates) const override {}
+    };
+
+    // New size; the bounds keep whatever they had around it (outline)
+    void resize(sf::Vector2f sz) {
+        bounds_.size += sz - size_;
+        size_ = sz;
+    }
+
+    const void*   native_;
+    sf::Vector2f  position_;
+    sf::Vector2f  size_;
+    sf::FloatRect bounds_;
+    sf::Vector2f  origin_;
+    sf::Vector2f  scale_;
+    float         rotation_;
+    Resize        resize_;
+    std::optional<sf::Vector2f> requested_;
+};
+
+} // namespace adapters
@@ -0,0 +1,207 @@
+#pragma once
+#include "../contracts/NineSlice.hpp"
+#include "../utilities/Trace.hpp"
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/PrimitiveType.hpp>
+#include <SFML/Graphics/RenderStates.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Sprite.hpp>
+#include <SFML/Graphics/VertexArray.hpp>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <unordered_map>
+
+namespace adapters {
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  NinePatch
+//
+//  border-image for sprites: the sprite's texture rect is cut into nine
+//  patches by the slice insets; corners keep their size, edges stretch
+//  along one axis and the middle (with `fill`) along both. The whole panel
+//  is one sf::VertexArray — one draw instead of nine sprites.
+//
+//  A sliced sprite no longer scales to its CSS size: SpriteAdapter routes
+//  setSize() here and draws this in place of the sprite (drawable()). The
+//  sprite still provides texture, texture rect, color and transform.
+//
+//  Meshes are cached by (size, resolved insets and widths, texture rect,
+//  color) and shared; an element looks its mesh up again only when one of
+//  those changes, i.e. on resize.
+// ─────────────────────────────────────────────────────────────────────────────
+
+class NinePatch final : public sf::Drawable {
+public:
+    // An empty slice is kept (border-image-width may arrive before the
+    // slice) but inactive: find() skips it and the sprite draws as usual.
+    static void set(const sf::Sprite& sprite, const contracts::NineSlice& slice) {
+        auto& slot = registry()[&sprite];
+        if (!slot) slot = std::make_unique<NinePatch>(sprite);
+        if (slot->slice_ == slice) return;
+        slot->slice_ = slice;
+        slot->mesh_.reset();
+    }
+
+    [[nodiscard]] static NinePatch* find(const void* native) {
+        auto& all = registry();
+        auto it = all.find(native);
+        return it != all.end() && !it->second->slice_.empty() ? it->second.get() : nullptr;
+    }
+
+    [[nodiscard]] static contracts::NineSlice sliceOf(const void* native) {
+        auto& all = registry();
+        auto it = all.find(native);
+        return it != all.end() ? it->second->slice_ : contracts::NineSlice{};
+    }
+
+    static void forget(const void* native) { registry().erase(native); }
+
+    explicit NinePatch(const sf::Sprite& sprite) : sprite_(&sprite) {}
+
+    [[nodiscard]] const contracts::NineSlice& slice() const { return slice_; }
+    [[nodiscard]] sf::Vector2f size() const { return size_; }
+    void resize(sf::Vector2f size) { size_ = { std::max(0.f, size.x), std::max(0.f, size.y) }; }
+
+    // Uncached build — sf::PrimitiveType::Triangles, up to 9 quads
+    static sf::VertexArray build(sf::Vector2f size, const contracts::NineSlice& slice,
+                                 const sf::IntRect& rect, sf::Color color) {
+        CSS_TRACE_ZONE("NinePatch::build");
+        sf::VertexArray out(sf::PrimitiveType::Triangles);
+        const Resolved r = resolve(size, slice, rect);
+
+        // Column/row edges on screen and in the texture
+        const float xs[4] = { 0.f, r.width[3], size.x - r.width[1], size.x };
+        const float ys[4] = { 0.f, r.width[0], size.y - r.width[2], size.y };
+        const float ox = static_cast<float>(rect.position.x), oy = static_cast<float>(rect.position.y);
+        const float tw = static_cast<float>(rect.size.x),     th = static_cast<float>(rect.size.y);
+        const float us[4] = { ox, ox + r.slice[3], ox + tw - r.slice[1], ox + tw };
+        const float vs[4] = { oy, oy + r.slice[0], oy + th - r.slice[2], oy + th };
+
+        for (int row = 0; row < 3; ++row) {
+            for (int col = 0; col < 3; ++col) {
+                if (row == 1 && col == 1 && !slice.fill) continue;
+                if (xs[col + 1] <= xs[col] || ys[row + 1] <= ys[row]) continue;
+
+                const sf::Vertex tl{ { xs[col],     ys[row]     }, color, { us[col],     vs[row]     } };
+                const sf::Vertex tr{ { xs[col + 1], ys[row]     }, color, { us[col + 1], vs[row]     } };
+                const sf::Vertex br{ { xs[col + 1], ys[row + 1] }, color, { us[col + 1], vs[row + 1] } };
+                const sf::Vertex bl{ { xs[col],     ys[row + 1] }, color, { us[col],     vs[row + 1] } };
+                out.append(tl); out.append(tr); out.append(br);
+                out.append(tl); out.append(br); out.append(bl);
+            }
+        }
+        return out;
+    }
+
+    [[nodiscard]] static std::size_t cachedMeshes() { return meshes().size(); }
+
+protected:
+    void draw(sf::RenderTarget& target, sf::RenderStates states) const override {
+        refresh();
+        if (!mesh_ || mesh_->getVertexCount() == 0) return;
+        states.transform *= sprite_->getTransform();
+        states.texture = &sprite_->getTexture();
+        target.draw(*mesh_, states);
+    }
+
+private:
+    // Insets in texture px and border widths in screen px, clamped so
+    // opposite sides never overlap
+    struct Resolved {
+        std::array<float, 4> slice;
+        std::array<float, 4> width;
+    };
+
+    static Resolved resolve(sf::Vector2f size, const contracts::NineSlice& s, const sf::IntRect& rect) {
+        Resolved r{};
+        const float tw = std::abs(static_cast<float>(rect.size.x));
+        const float th = std::abs(static_cast<float>(rect.size.y));
+        for (int i = 0; i < 4; ++i) {
+            const float extent = (i % 2 == 0) ? th : tw;
+            r.slice[i] = std::clamp(s.slicePercent[i] ? s.slice[i] * extent : s.slice[i], 0.f, extent);
+            r.width[i] = std::max(0.f, s.widthMultiple[i] ? s.width[i] * r.slice[i] : s.width[i]);
+        }
+        auto fit = [](float& a, float& b, float limit) {
+            if (a + b > limit && a + b > 0.f) { const float k = limit / (a + b); a *= k; b *= k; }
+        };
+        fit(r.slice[0], r.slice[2], th);  fit(r.slice[1], r.slice[3], tw);
+        fit(r.width[0], r.width[2], size.y); fit(r.width[1], r.width[3], size.x);
+        return r;
+    }
+
+    void refresh() const {
+        const sf::IntRect rect  = sprite_->getTextureRect();
+        const sf::Color   color = sprite_->getColor();
+        if (mesh_ && size_ == builtSize_ && rect == builtRect_ && color == builtColor_) return;
+
+        Key key{ size_, resolve(size_, slice_, rect), rect, color, slice_.fill };
+        auto& cache = meshes();
+        auto it = cache.find(key);
+        if (it == cache.end()) {
+            if (cache.size() >= kCapacity) {
+                for (auto e = cache.begin(); e != cache.end();)
+                    e = e->second.use_count() == 1 ? cache.erase(e) : std::next(e);
+                if (cache.size() >= kCapacity) cache.clear();
+            }
+            auto mesh = std::make_shared<const sf::VertexArray>(build(size_, slice_, rect, color));
+            it = cache.emplace(key, std::move(mesh)).first;
+        }
+        mesh_       = it->second;
+        builtSize_  = size_;
+        builtRect_  = rect;
+        builtColor_ = color;
+    }
+
+    // ── Cache ─────────────────────────────────────────────────────────────
+    static constexpr std::size_t kCapacity = 256;
+
+    struct Key {
+        sf::Vector2f size;
+        Resolved     resolved;
+        sf::IntRect  rect;
+        sf::Color    color;
+        bool         fill;
+        bool operator==(const Key& o) const {
+            return size == o.size && resolved.slice == o.resolved.slice && resolved.width == o.resolved.width
+                && rect == o.rect && color == o.color && fill == o.fill;
+        }
+    };
+    struct KeyHash {
+        std::size_t operator()(const Key& k) const {
+            std::uint64_t h = 0xcbf29ce484222325ull;
+            auto mix = [&h](std::uint32_t v) { h ^= v; h *= 0x100000001b3ull; };
+            auto mixf = [&mix](float v) { std::uint32_t b; std::memcpy(&b, &v, 4); mix(b); };
+            mixf(k.size.x); mixf(k.size.y);
+            for (int i = 0; i < 4; ++i) { mixf(k.resolved.slice[i]); mixf(k.resolved.width[i]); }
+            mix(static_cast<std::uint32_t>(k.rect.position.x)); mix(static_cast<std::uint32_t>(k.rect.position.y));
+            mix(static_cast<std::uint32_t>(k.rect.size.x));     mix(static_cast<std::uint32_t>(k.rect.size.y));
+            mix(k.color.toInteger());
+            mix(k.fill ? 1u : 0u);
+            return static_cast<std::size_t>(h);
+        }
+    };
+
+    static std::unordered_map<Key, std::shared_ptr<const sf::VertexArray>, KeyHash>& meshes() {
+        static std::unordered_map<Key, std::shared_ptr<const sf::VertexArray>, KeyHash> m;
+        return m;
+    }
+
+    static std::unordered_map<const void*, std::unique_ptr<NinePatch>>& registry() {
+        static std::unordered_map<const void*, std::unique_ptr<NinePatch>> r;
+        return r;
+    }
+
+    const sf::Sprite*    sprite_;
+    contracts::NineSlice slice_;
+    sf::Vector2f         size_;
+
+    mutable std::shared_ptr<const sf::VertexArray> mesh_;
+    mutable sf::Vector2f                           builtSize_;
+    mutable sf::IntRect                            builtRect_;
+    mutable sf::Color                              builtColor_;
+};
+
+} // namespace adapters
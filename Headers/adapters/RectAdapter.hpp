@@ -1,4 +1,5 @@
 #pragma once
+#include "RoundedRect.hpp"
 #include "ShapeAdapterBase.hpp"
 #include <SFML/Graphics/RectangleShape.hpp>
 
@@ -10,12 +11,31 @@ public:
 
     // RectangleShape has an explicit setSize / getSize pair
     void setSize(sf::Vector2f sz) override {
+        CSS_TRACE_COUNT(SfmlSetterCalls);
+        touch(Dirty::Geometry, shape_->getSize(), sz);
         shape_->setSize(sz);
     }
     sf::Vector2f getSize() const override {
         return shape_->getSize();
     }
 
+    // Rounded corners are drawn through a RoundedRect stand-in
+    void setBorderRadius(const contracts::BorderRadius& r) override {
+        CSS_TRACE_COUNT(SfmlSetterCalls);
+        touch(Dirty::Paint, getBorderRadius(), r);
+        RoundedRect::set(*shape_, r);
+    }
+    contracts::BorderRadius getBorderRadius() const override {
+        const RoundedRect* rounded = RoundedRect::find(shape_);
+        return rounded ? rounded->radius() : contracts::BorderRadius{};
+    }
+    const sf::Drawable& drawable() const override {
+        if (const DropShadow* shadow = DropShadow::find(shape_)) return *shadow;
+        if (const Background* background = Background::find(shape_)) return *background;
+        const RoundedRect* rounded = RoundedRect::find(shape_);
+        return rounded ? static_cast<const sf::Drawable&>(*rounded) : *shape_;
+    }
+
     std::string typeName() const override { return "RectangleShape"; }
 };
 
@@ -0,0 +1,267 @@
+#pragma once
+#include "../contracts/BorderRadius.hpp"
+#include "../utilities/Trace.hpp"
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/PrimitiveType.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/RectangleShape.hpp>
+#include <SFML/Graphics/RenderStates.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace adapters {
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  RoundedRect
+//
+//  border-radius for sf::RectangleShape. SFML rectangles always have four
+//  points, so a rounded element is drawn through a RoundedRect that stands
+//  in for the rectangle in CSS::drawAll (RectAdapter::drawable()). It reads
+//  size, transform, colors and outline from the rectangle at draw time, so
+//  the rectangle stays the element's single source of truth, texture and
+//  texture rect included.
+//
+//  Geometry (fill fan + outline ring, in local coordinates) is cached by
+//  (size, resolved radii, per-corner segment count, outline thickness) and
+//  shared by every element with the same shape. Per element only the
+//  colored vertex copy is kept, rebuilt when geometry or colors change.
+//
+//  Segment count per corner follows the on-screen radius (radius × scale):
+//  enough segments to keep the chord within kTolerance pixels of the arc,
+//  so a 4px corner costs 2 segments and a 200px one about 14.
+// ─────────────────────────────────────────────────────────────────────────────
+
+class RoundedRect final : public sf::Drawable {
+public:
+    static constexpr float kTolerance   = 0.35f;   // max chord-to-arc distance, px
+    static constexpr int   kMaxSegments = 64;
+
+    struct Geometry {
+        std::vector<sf::Vector2f> fill;     // triangle fan: center, outline…, first
+        std::vector<sf::Vector2f> ring;     // triangle strip: inner/outer pairs, closed
+    };
+
+    // ── Per-element registry ──────────────────────────────────────────────
+    static void set(const sf::RectangleShape& rect, const contracts::BorderRadius& radius) {
+        auto& all = registry();
+        if (radius.empty()) { all.erase(&rect); return; }
+        auto& slot = all[&rect];
+        if (!slot) slot = std::make_unique<RoundedRect>(rect);
+        slot->radius_ = radius;
+    }
+
+    [[nodiscard]] static const RoundedRect* find(const void* native) {
+        auto& all = registry();
+        auto it = all.find(native);
+        return it != all.end() ? it->second.get() : nullptr;
+    }
+
+    static void forget(const void* native) { registry().erase(native); }
+
+    explicit RoundedRect(const sf::RectangleShape& rect) : rect_(&rect) {}
+
+    [[nodiscard]] const contracts::BorderRadius& radius() const { return radius_; }
+
+    // Current fill outline (local coordinates, clockwise), as last drawn
+    [[nodiscard]] std::vector<sf::Vector2f> outline() const {
+        if (!geo_ || geo_->fill.size() < 3) return {};
+        return { geo_->fill.begin() + 1, geo_->fill.end() - 1 };
+    }
+
+    // ── Shared geometry ───────────────────────────────────────────────────
+    // rx/ry per corner in CSS order, already resolved and clamped.
+    static std::shared_ptr<const Geometry> geometry(
+        sf::Vector2f size, const std::array<float, 4>& rx, const std::array<float, 4>& ry,
+        const std::array<int, 4>& segments, float thickness
+    ) {
+        Key key{};
+        key.f = { size.x, size.y, rx[0], rx[1], rx[2], rx[3], ry[0], ry[1], ry[2], ry[3], thickness };
+        key.s = segments;
+
+        auto& cache = geometries();
+        auto it = cache.find(key);
+        if (it != cache.end()) return it->second;
+
+        if (cache.size() >= kCapacity) evictUnused();
+
+        CSS_TRACE_ZONE("RoundedRect::tessellate");
+        auto geo = std::make_shared<Geometry>();
+        std::vector<sf::Vector2f> inner, outer;
+        outline(size, rx, ry, segments, 0.f, inner);
+        outline(size, rx, ry, segments, thickness, outer);
+
+        sf::Vector2f c{ size.x / 2.f, size.y / 2.f };
+        geo->fill.reserve(inner.size() + 2);
+        geo->fill.push_back(c);
+        geo->fill.insert(geo->fill.end(), inner.begin(), inner.end());
+        geo->fill.push_back(inner.front());
+
+        if (thickness != 0.f) {
+            geo->ring.reserve(inner.size() * 2 + 2);
+            for (std::size_t i = 0; i < inner.size(); ++i) {
+                geo->ring.push_back(inner[i]);
+                geo->ring.push_back(outer[i]);
+            }
+            geo->ring.push_back(inner.front());
+            geo->ring.push_back(outer.front());
+        }
+
+        cache.emplace(key, geo);
+        return geo;
+    }
+
+    // Segments for a quarter arc of on-screen radius r
+    static int segmentsFor(float r) {
+        if (r <= kTolerance) return r > 0.f ? 1 : 0;
+        const float step = 2.f * std::acos(1.f - kTolerance / r);
+        return std::clamp(static_cast<int>(std::ceil(1.5707964f / step)), 1, kMaxSegments);
+    }
+
+    // Resolves percentages, then scales all radii down together if they
+    // overlap (CSS corner clamping)
+    static void resolve(const contracts::BorderRadius& radius, sf::Vector2f size,
+                        std::array<float, 4>& rx, std::array<float, 4>& ry) {
+        for (int i = 0; i < 4; ++i) {
+            rx[i] = std::max(0.f, radius.percent[i] ? radius.value[i] * size.x : radius.value[i]);
+            ry[i] = std::max(0.f, radius.percent[i] ? radius.value[i] * size.y : radius.value[i]);
+        }
+        float f = 1.f;
+        auto limit = [&f](float sum, float side) { if (sum > side && sum > 0.f) f = std::min(f, side / sum); };
+        limit(rx[0] + rx[1], size.x); limit(rx[3] + rx[2], size.x);
+        limit(ry[0] + ry[3], size.y); limit(ry[1] + ry[2], size.y);
+        for (int i = 0; i < 4; ++i) { rx[i] *= f; ry[i] *= f; }
+    }
+
+    [[nodiscard]] static std::size_t cachedGeometries() { return geometries().size(); }
+
+protected:
+    void draw(sf::RenderTarget& target, sf::RenderStates states) const override {
+        refresh();
+        states.transform *= rect_->getTransform();
+        if (fill_.size()) {
+            states.texture = rect_->getTexture();
+            target.draw(fill_.data(), fill_.size(), sf::PrimitiveType::TriangleFan, states);
+            states.texture = nullptr;
+        }
+        if (ring_.size())
+            target.draw(ring_.data(), ring_.size(), sf::PrimitiveType::TriangleStrip, states);
+    }
+
+private:
+    struct Key {
+        std::array<float, 11> f;
+        std::array<int, 4>    s;
+        bool operator==(const Key& o) const { return f == o.f && s == o.s; }
+    };
+    struct KeyHash {
+        std::size_t operator()(const Key& k) const {
+            std::uint64_t h = 0xcbf29ce484222325ull;
+            auto mix = [&h](std::uint32_t v) { h ^= v; h *= 0x100000001b3ull; };
+            for (float v : k.f) { std::uint32_t b; std::memcpy(&b, &v, 4); mix(b); }
+            for (int v : k.s) mix(static_cast<std::uint32_t>(v));
+            return static_cast<std::size_t>(h);
+        }
+    };
+
+    static constexpr std::size_t kCapacity = 1024;
+
+    // Rebuilds the colored copy only when the shared geometry or a color changed
+    void refresh() const {
+        const sf::Vector2f size  = rect_->getSize();
+        const sf::Vector2f scale = rect_->getScale();
+        const float screen = std::max(std::abs(scale.x), std::abs(scale.y));
+
+        std::array<float, 4> rx{}, ry{};
+        resolve(radius_, size, rx, ry);
+        std::array<int, 4> seg{};
+        for (int i = 0; i < 4; ++i) seg[i] = segmentsFor(std::max(rx[i], ry[i]) * screen);
+
+        auto geo = geometry(size, rx, ry, seg, rect_->getOutlineThickness());
+        const sf::Color fill = rect_->getFillColor(), line = rect_->getOutlineColor();
+        const sf::IntRect tex = rect_->getTextureRect();
+        if (geo == geo_ && fill == fillColor_ && line == lineColor_ && tex == texRect_) return;
+
+        geo_ = std::move(geo);
+        fillColor_ = fill;
+        lineColor_ = line;
+        texRect_   = tex;
+
+        // Texture coordinates map the box onto the texture rect, as sf::Shape does
+        const sf::Vector2f k{ size.x > 0.f ? static_cast<float>(tex.size.x) / size.x : 0.f,
+                              size.y > 0.f ? static_cast<float>(tex.size.y) / size.y : 0.f };
+        fill_.resize(geo_->fill.size());
+        for (std::size_t i = 0; i < fill_.size(); ++i) {
+            const sf::Vector2f p = geo_->fill[i];
+            fill_[i] = { p, fill, { static_cast<float>(tex.position.x) + p.x * k.x,
+                                    static_cast<float>(tex.position.y) + p.y * k.y } };
+        }
+        ring_.resize(geo_->ring.size());
+        for (std::size_t i = 0; i < ring_.size(); ++i) ring_[i] = { geo_->ring[i], line, {} };
+    }
+
+    // Perimeter clockwise from the top-left corner, grown by `offset`
+    // (outline thickness grows outward like sf::Shape). Square corners stay
+    // square when offset. Every call with the same segments yields the same
+    // point count, so inner and outer outlines pair up.
+    static void outline(sf::Vector2f size, const std::array<float, 4>& rx, const std::array<float, 4>& ry,
+                        const std::array<int, 4>& segments, float offset, std::vector<sf::Vector2f>& out) {
+        out.clear();
+        const float left = -offset, top = -offset;
+        const float right = size.x + offset, bottom = size.y + offset;
+        // Corner centers and start angles (y points down): TL 180°, TR 270°, BR 0°, BL 90°
+        const float start[4] = { 3.1415927f, 4.712389f, 0.f, 1.5707964f };
+
+        for (int c = 0; c < 4; ++c) {
+            const float ax = rx[c] > 0.f ? std::max(0.f, rx[c] + offset) : 0.f;
+            const float ay = ry[c] > 0.f ? std::max(0.f, ry[c] + offset) : 0.f;
+            const float cx = (c == 0 || c == 3) ? left + ax : right - ax;
+            const float cy = (c == 0 || c == 1) ? top  + ay : bottom - ay;
+
+            const int n = segments[c];
+            if (n == 0) {
+                out.push_back({ cx, cy });
+                continue;
+            }
+            for (int k = 0; k <= n; ++k) {
+                const float a = start[c] + 1.5707964f * static_cast<float>(k) / static_cast<float>(n);
+                out.push_back({ cx + ax * std::cos(a), cy + ay * std::sin(a) });
+            }
+        }
+    }
+
+    static void evictUnused() {
+        auto& cache = geometries();
+        for (auto it = cache.begin(); it != cache.end();)
+            it = it->second.use_count() == 1 ? cache.erase(it) : std::next(it);
+        if (cache.size() >= kCapacity) cache.clear();
+    }
+
+    static std::unordered_map<Key, std::shared_ptr<const Geometry>, KeyHash>& geometries() {
+        static std::unordered_map<Key, std::shared_ptr<const Geometry>, KeyHash> g;
+        return g;
+    }
+
+    static std::unordered_map<const void*, std::unique_ptr<RoundedRect>>& registry() {
+        static std::unordered_map<const void*, std::unique_ptr<RoundedRect>> r;
+        return r;
+    }
+
+    const sf::RectangleShape*               rect_;
+    contracts::BorderRadius                 radius_;
+
+    // Colored copy of the shared geometry
+    mutable std::shared_ptr<const Geometry> geo_;
+    mutable sf::Color                       fillColor_, lineColor_;
+    mutable sf::IntRect                     texRect_;
+    mutable std::vector<sf::Vertex>         fill_, ring_;
+};
+
+} // namespace adapters
@@ -1,6 +1,13 @@
 #pragma once
 #include "../contracts/IStyleable.hpp"
+#include "../utilities/DirtySet.hpp"
+#include "../utilities/Trace.hpp"
+#include "Background.hpp"
+#include "DropShadow.hpp"
+#include "ImageAtlas.hpp"
+#include <SFML/Graphics/CircleShape.hpp>
 #include <SFML/Graphics/Shape.hpp>
+#include <type_traits>
 
 namespace adapters {
 
@@ -12,6 +19,9 @@ namespace adapters {
 //
 //  Concrete adapters inherit from this and only override what differs
 //  (e.g. setSize maps to different calls for Rect vs Circle).
+//
+//  Every mutation that changes what is drawn is recorded in DirtySet
+//  (touch()) for damage tracking.
 // ─────────────────────────────────────────────────────────────────────────────
 
 template<typename ShapeT>
@@ -23,6 +33,8 @@ public:
     sf::Vector2f getPosition() const override { return shape_->getPosition(); }
     sf::Vector2f getOrigin()   const override { return shape_->getOrigin(); }
     sf::Vector2f getScale()    const override { return shape_->getScale(); }
+    float        getRotation() const override { return shape_->getRotation().asDegrees(); }
+    sf::Transform getTransform() const override { return shape_->getTransform(); }
 
     sf::FloatRect getBounds() const override {
         return shape_->getLocalBounds();
@@ -31,23 +43,76 @@ public:
         auto b = shape_->getLocalBounds();
         return { b.size.x, b.size.y };
     }
+    sf::FloatRect getVisualBounds() const override {
+        const sf::FloatRect b = getBounds();
+        const DropShadow* shadow = DropShadow::find(shape_);
+        if (!shadow) return b;
+        const sf::FloatRect s = shadow->bounds();
+        const sf::Vector2f lo{ std::min(b.position.x, s.position.x), std::min(b.position.y, s.position.y) };
+        const sf::Vector2f hi{ std::max(b.position.x + b.size.x, s.position.x + s.size.x),
+                               std::max(b.position.y + b.size.y, s.position.y + s.size.y) };
+        return { lo, hi - lo };
+    }
 
     // ── Geometry mutations ─────────────────────────────────────────────────
-    void setPosition(sf::Vector2f p) override { shape_->setPosition(p); }
-    void move       (sf::Vector2f d) override { shape_->move(d); }
-    void setOrigin  (sf::Vector2f o) override { shape_->setOrigin(o); }
-    void setScale   (sf::Vector2f s) override { shape_->setScale(s); }
-    void setRotation(float deg)      override { shape_->setRotation(sf::degrees(deg)); }
+    void setPosition(sf::Vector2f p) override { CSS_TRACE_COUNT(SfmlSetterCalls); touch(Dirty::Geometry, shape_->getPosition(), p); shape_->setPosition(p); }
+    void move       (sf::Vector2f d) override { CSS_TRACE_COUNT(SfmlSetterCalls); touch(Dirty::Geometry, sf::Vector2f{}, d); shape_->move(d); }
+    void setOrigin  (sf::Vector2f o) override { CSS_TRACE_COUNT(SfmlSetterCalls); touch(Dirty::Geometry, shape_->getOrigin(), o); shape_->setOrigin(o); }
+    void setScale   (sf::Vector2f s) override { CSS_TRACE_COUNT(SfmlSetterCalls); touch(Dirty::Geometry, shape_->getScale(), s); shape_->setScale(s); }
+    void setRotation(float deg)      override { CSS_TRACE_COUNT(SfmlSetterCalls); touch(Dirty::Geometry, shape_->getRotation(), sf::degrees(deg)); shape_->setRotation(sf::degrees(deg)); }
 
     // ── Color / visual mutations ───────────────────────────────────────────
-    void setFillColor       (sf::Color c) override { shape_->setFillColor(c); }
-    void setOutlineColor    (sf::Color c) override { shape_->setOutlineColor(c); }
-    void setOutlineThickness(float t)     override { shape_->setOutlineThickness(t); }
+    void setFillColor       (sf::Color c) override { CSS_TRACE_COUNT(SfmlSetterCalls); touch(Dirty::Paint, shape_->getFillColor(), c); shape_->setFillColor(c); }
+    void setOutlineColor    (sf::Color c) override { CSS_TRACE_COUNT(SfmlSetterCalls); touch(Dirty::Paint, shape_->getOutlineColor(), c); shape_->setOutlineColor(c); }
+    void setOutlineThickness(float t)     override { CSS_TRACE_COUNT(SfmlSetterCalls); touch(Dirty::Paint, shape_->getOutlineThickness(), t); shape_->setOutlineThickness(t); }
     sf::Color getFillColor() const        override { return shape_->getFillColor(); }
+    sf::Color getOutlineColor() const     override { return shape_->getOutlineColor(); }
+    float getOutlineThickness() const     override { return shape_->getOutlineThickness(); }
+
+    void setBoxShadow(const contracts::BoxShadow& s) override {
+        CSS_TRACE_COUNT(SfmlSetterCalls);
+        const DropShadow* current = DropShadow::find(shape_);
+        touch(Dirty::Paint, current ? current->shadow() : contracts::BoxShadow{}, s);
+        DropShadow::set(*shape_, s, std::is_base_of_v<sf::CircleShape, ShapeT>);
+    }
+
+    void setBackgroundGradient(const contracts::Gradient& g) override {
+        CSS_TRACE_COUNT(SfmlSetterCalls);
+        const Background* current = Background::find(shape_);
+        touch(Dirty::Paint, current ? current->gradient() : contracts::Gradient{}, g);
+        Background::setGradient(*shape_, g);
+    }
+
+    // The fill color tints the image, as with any textured sf::Shape. Until
+    // the image is decoded the plain fill color stands in for it.
+    void setBackgroundImage(const std::string& path) override {
+        CSS_TRACE_COUNT(SfmlSetterCalls);
+        const auto region = path.empty() ? std::nullopt : ImageAtlas::request(path, shape_);
+        const sf::Texture* texture = region ? ImageAtlas::texture(region->page) : nullptr;
+        touch(Dirty::Paint, shape_->getTexture(), texture);
+        shape_->setTexture(texture);
+        if (texture) {
+            touch(Dirty::Paint, shape_->getTextureRect(), region->rect);
+            shape_->setTextureRect(region->rect);
+        }
+    }
 
     std::string typeName() const override { return "Shape"; }
+    const void* native()   const override { return shape_; }
+    const sf::Drawable& drawable() const override {
+        if (const DropShadow* shadow = DropShadow::find(shape_)) return *shadow;
+        const Background* background = Background::find(shape_);
+        return background ? static_cast<const sf::Drawable&>(*background) : *shape_;
+    }
 
 protected:
+    using Dirty = utilities::DirtySet;
+
+    template<typename T>
+    void touch(Dirty::Kind kind, const T& before, const T& after) const {
+        Dirty::mark(shape_, kind, before, after);
+    }
+
     ShapeT* shape_;
 };
 
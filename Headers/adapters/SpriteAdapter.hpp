@@ -1,5 +1,9 @@
 #pragma once
 #include "../contracts/IStyleable.hpp"
+#include "../utilities/DirtySet.hpp"
+#include "../utilities/Trace.hpp"
+#include "ImageAtlas.hpp"
+#include "NinePatch.hpp"
 #include <SFML/Graphics/Sprite.hpp>
 
 namespace adapters {
@@ -12,11 +16,15 @@ public:
     sf::Vector2f getPosition() const override { return sprite_->getPosition(); }
     sf::Vector2f getOrigin()   const override { return sprite_->getOrigin(); }
     sf::Vector2f getScale()    const override { return sprite_->getScale(); }
+    float        getRotation() const override { return sprite_->getRotation().asDegrees(); }
+    sf::Transform getTransform() const override { return sprite_->getTransform(); }
 
     sf::FloatRect getBounds() const override {
+        if (const auto* patch = NinePatch::find(sprite_)) return { {}, patch->size() };
         return sprite_->getLocalBounds();
     }
     sf::Vector2f getSize() const override {
+        if (const auto* patch = NinePatch::find(sprite_)) return patch->size();
         // For sprites, report the scaled visual size
         auto b = sprite_->getLocalBounds();
         auto s = sprite_->getScale();
@@ -24,30 +32,83 @@ public:
     }
 
     // ── Geometry mutations ─────────────────────────────────────────────────
-    void setPosition(sf::Vector2f p) override { sprite_->setPosition(p); }
-    void move       (sf::Vector2f d) override { sprite_->move(d); }
-    void setOrigin  (sf::Vector2f o) override { sprite_->setOrigin(o); }
-    void setRotation(float deg)      override { sprite_->setRotation(sf::degrees(deg)); }
+    void setPosition(sf::Vector2f p) override { CSS_TRACE_COUNT(SfmlSetterCalls); touch(Dirty::Geometry, sprite_->getPosition(), p); sprite_->setPosition(p); }
+    void move       (sf::Vector2f d) override { CSS_TRACE_COUNT(SfmlSetterCalls); touch(Dirty::Geometry, sf::Vector2f{}, d); sprite_->move(d); }
+    void setOrigin  (sf::Vector2f o) override { CSS_TRACE_COUNT(SfmlSetterCalls); touch(Dirty::Geometry, sprite_->getOrigin(), o); sprite_->setOrigin(o); }
+    void setRotation(float deg)      override { CSS_TRACE_COUNT(SfmlSetterCalls); touch(Dirty::Geometry, sprite_->getRotation(), sf::degrees(deg)); sprite_->setRotation(sf::degrees(deg)); }
 
-    // Sprites scale to achieve a target size
+    // Sprites scale to achieve a target size; sliced sprites stay at scale 1
+    // and stretch their 9-patch instead
     void setSize(sf::Vector2f target) override {
+        if (auto* patch = NinePatch::find(sprite_)) {
+            CSS_TRACE_COUNT(SfmlSetterCalls);
+            touch(Dirty::Geometry, patch->size(), target);
+            patch->resize(target);
+            return;
+        }
         auto b = sprite_->getLocalBounds();
-        if (b.size.x > 0.f && b.size.y > 0.f)
-            sprite_->setScale({ target.x / b.size.x, target.y / b.size.y });
+        if (b.size.x > 0.f && b.size.y > 0.f) {
+            CSS_TRACE_COUNT(SfmlSetterCalls);
+            setScale({ target.x / b.size.x, target.y / b.size.y });
+        }
     }
-    void setScale(sf::Vector2f s) override { sprite_->setScale(s); }
+    void setScale(sf::Vector2f s) override { CSS_TRACE_COUNT(SfmlSetterCalls); touch(Dirty::Geometry, sprite_->getScale(), s); sprite_->setScale(s); }
 
     // ── Color / visual mutations ───────────────────────────────────────────
     // sf::Sprite uses setColor (tint), not setFillColor
-    void setFillColor       (sf::Color c) override { sprite_->setColor(c); }
+    void setFillColor       (sf::Color c) override { CSS_TRACE_COUNT(SfmlSetterCalls); touch(Dirty::Paint, sprite_->getColor(), c); sprite_->setColor(c); }
     void setOutlineColor    (sf::Color)   override {} // not supported
     void setOutlineThickness(float)       override {} // not supported
     sf::Color getFillColor() const        override { return sprite_->getColor(); }
 
+    // Points the sprite at the image's sub-rect of a shared atlas page.
+    // A sprite always has a texture, so it keeps its current one while the
+    // image decodes, and for an empty or unreadable path.
+    void setBackgroundImage(const std::string& path) override {
+        if (path.empty()) return;
+        const auto region = ImageAtlas::request(path, sprite_);
+        if (!region) return;
+        if (const sf::Texture* texture = ImageAtlas::texture(region->page)) {
+            CSS_TRACE_COUNT(SfmlSetterCalls);
+            touch(Dirty::Paint, &sprite_->getTexture(), texture);
+            touch(Dirty::Paint, sprite_->getTextureRect(), region->rect);
+            sprite_->setTexture(*texture);
+            sprite_->setTextureRect(region->rect);
+        }
+    }
+
+    // Switching slicing on or off keeps the on-screen size: the scale moves
+    // into the patch size, or back out of it
+    void setNineSlice(const contracts::NineSlice& slice) override {
+        const sf::Vector2f size = getSize();
+        touch(Dirty::Paint, getNineSlice(), slice);
+        NinePatch::set(*sprite_, slice);
+        if (auto* patch = NinePatch::find(sprite_)) {
+            CSS_TRACE_COUNT(SfmlSetterCalls);
+            patch->resize(size);
+            setScale({ 1.f, 1.f });
+        } else {
+            setSize(size);
+        }
+    }
+    contracts::NineSlice getNineSlice() const override { return NinePatch::sliceOf(sprite_); }
+
     bool        isSprite() const override { return true; }
     std::string typeName() const override { return "Sprite"; }
+    const void* native()   const override { return sprite_; }
+    const sf::Drawable& drawable() const override {
+        if (const auto* patch = NinePatch::find(sprite_)) return *patch;
+        return *sprite_;
+    }
 
 private:
+    using Dirty = utilities::DirtySet;
+
+    template<typename T>
+    void touch(Dirty::Kind kind, const T& before, const T& after) const {
+        Dirty::mark(sprite_, kind, before, after);
+    }
+
     sf::Sprite* sprite_;
 };
 
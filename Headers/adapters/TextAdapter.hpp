@@ -1,5 +1,10 @@
 #pragma once
 #include "../contracts/IStyleable.hpp"
+#include "../utilities/DirtySet.hpp"
+#include "../utilities/Trace.hpp"
+#include "TextMeasureCache.hpp"
+#include "TextWrapper.hpp"
+#include "FontRegistry.hpp"
 #include <SFML/Graphics/Text.hpp>
 
 namespace adapters {
@@ -12,40 +17,101 @@ public:
     sf::Vector2f getPosition() const override { return text_->getPosition(); }
     sf::Vector2f getOrigin()   const override { return text_->getOrigin(); }
     sf::Vector2f getScale()    const override { return text_->getScale(); }
+    float        getRotation() const override { return text_->getRotation().asDegrees(); }
+    sf::Transform getTransform() const override { return text_->getTransform(); }
 
+    // Bounds go through the shared measurement cache — getLocalBounds()
+    // rebuilds glyph geometry and layout queries the same label repeatedly.
     sf::FloatRect getBounds() const override {
-        return text_->getLocalBounds();
+        return TextMeasureCache::localBounds(*text_);
     }
     sf::Vector2f getSize() const override {
-        auto b = text_->getLocalBounds();
+        auto b = TextMeasureCache::localBounds(*text_);
         return { b.size.x, b.size.y };
     }
 
     // ── Geometry mutations ─────────────────────────────────────────────────
-    void setPosition(sf::Vector2f p) override { text_->setPosition(p); }
-    void move       (sf::Vector2f d) override { text_->move(d); }
-    void setOrigin  (sf::Vector2f o) override { text_->setOrigin(o); }
-    void setScale   (sf::Vector2f s) override { text_->setScale(s); }
-    void setRotation(float deg)      override { text_->setRotation(sf::degrees(deg)); }
-    // Text has no setSize — font size is controlled via setCharacterSize
-    void setSize(sf::Vector2f)       override {}
+    void setPosition(sf::Vector2f p) override { CSS_TRACE_COUNT(SfmlSetterCalls); touch(Dirty::Geometry, text_->getPosition(), p); text_->setPosition(p); }
+    void move       (sf::Vector2f d) override { CSS_TRACE_COUNT(SfmlSetterCalls); touch(Dirty::Geometry, sf::Vector2f{}, d); text_->move(d); }
+    void setOrigin  (sf::Vector2f o) override { CSS_TRACE_COUNT(SfmlSetterCalls); touch(Dirty::Geometry, text_->getOrigin(), o); text_->setOrigin(o); }
+    void setScale   (sf::Vector2f s) override { CSS_TRACE_COUNT(SfmlSetterCalls); touch(Dirty::Geometry, text_->getScale(), s); text_->setScale(s); }
+    void setRotation(float deg)      override { CSS_TRACE_COUNT(SfmlSetterCalls); touch(Dirty::Geometry, text_->getRotation(), sf::degrees(deg)); text_->setRotation(sf::degrees(deg)); }
+    // Width becomes the wrap width; height stays intrinsic (font size is
+    // controlled via setCharacterSize). Callers that only change y pass the
+    // current width back, which must not start wrapping an unwrapped label.
+    void setSize(sf::Vector2f sz) override {
+        if (sz.x == getSize().x) return;
+        Dirty::mark(text_, Dirty::Paint);
+        TextWrapper::setWidth(*text_, sz.x);
+    }
+
+    void wrapToMinContent() override {
+        Dirty::mark(text_, Dirty::Paint);
+        TextWrapper::setMinContent(*text_);
+    }
 
     // ── Color / visual mutations ───────────────────────────────────────────
-    void setFillColor       (sf::Color c) override { text_->setFillColor(c); }
-    void setOutlineColor    (sf::Color c) override { text_->setOutlineColor(c); }
-    void setOutlineThickness(float t)     override { text_->setOutlineThickness(t); }
+    void setFillColor       (sf::Color c) override { CSS_TRACE_COUNT(SfmlSetterCalls); touch(Dirty::Paint, text_->getFillColor(), c); text_->setFillColor(c); }
+    void setOutlineColor    (sf::Color c) override { CSS_TRACE_COUNT(SfmlSetterCalls); touch(Dirty::Paint, text_->getOutlineColor(), c); text_->setOutlineColor(c); }
+    void setOutlineThickness(float t)     override { CSS_TRACE_COUNT(SfmlSetterCalls); touch(Dirty::Paint, text_->getOutlineThickness(), t); text_->setOutlineThickness(t); }
     sf::Color getFillColor() const        override { return text_->getFillColor(); }
+    sf::Color getOutlineColor() const     override { return text_->getOutlineColor(); }
+    float getOutlineThickness() const     override { return text_->getOutlineThickness(); }
 
     // ── Text-only mutations ────────────────────────────────────────────────
-    void setCharacterSize(unsigned sz)      override { text_->setCharacterSize(sz); }
-    void setLetterSpacing(float f)          override { text_->setLetterSpacing(f); }
-    void setLineSpacing  (float f)          override { text_->setLineSpacing(f); }
-    void setTextStyle    (sf::Text::Style s)override { text_->setStyle(s); }
+    void setCharacterSize(unsigned sz)      override { CSS_TRACE_COUNT(SfmlSetterCalls); touch(Dirty::Paint, text_->getCharacterSize(), sz); text_->setCharacterSize(sz); FontRegistry::noteSize(text_->getFont(), sz); TextWrapper::reflow(*text_); }
+    void setLetterSpacing(float f)          override { CSS_TRACE_COUNT(SfmlSetterCalls); touch(Dirty::Paint, text_->getLetterSpacing(), f); text_->setLetterSpacing(f); TextWrapper::reflow(*text_); }
+    void setLineSpacing  (float f)          override { CSS_TRACE_COUNT(SfmlSetterCalls); touch(Dirty::Paint, text_->getLineSpacing(), f); text_->setLineSpacing(f); }
+    void setTextStyle    (sf::Text::Style s)override { CSS_TRACE_COUNT(SfmlSetterCalls); touch(Dirty::Paint, text_->getStyle(), static_cast<std::uint32_t>(s)); text_->setStyle(s); TextWrapper::reflow(*text_); }
+
+    // Unknown or unloadable families leave the current font in place
+    void setFontFamily(const std::string& families) override {
+        const sf::Font* font = FontRegistry::resolve(families);
+        if (!font) {
+            CSS_TRACE_COUNT(ParseFailures);
+            return;
+        }
+        if (&text_->getFont() == font) return;
+        CSS_TRACE_COUNT(SfmlSetterCalls);
+        Dirty::mark(text_, Dirty::Paint);
+        text_->setFont(*font);
+        FontRegistry::noteSize(*font, text_->getCharacterSize());
+        TextWrapper::reflow(*text_);
+    }
+
+    // ── Wrapping (state kept per sf::Text by TextWrapper) ─────────────────
+    void setWhiteSpace(contracts::TextWrap::WhiteSpace ws) override {
+        auto o = TextWrapper::options(*text_);
+        touch(Dirty::Paint, o.whiteSpace, ws);
+        o.whiteSpace = ws;
+        TextWrapper::setOptions(*text_, o);
+    }
+    void setOverflowWrap(contracts::TextWrap::OverflowWrap ow) override {
+        auto o = TextWrapper::options(*text_);
+        touch(Dirty::Paint, o.overflowWrap, ow);
+        o.overflowWrap = ow;
+        TextWrapper::setOptions(*text_, o);
+    }
+    void setTextOverflow(contracts::TextWrap::TextOverflow to) override {
+        auto o = TextWrapper::options(*text_);
+        touch(Dirty::Paint, o.textOverflow, to);
+        o.textOverflow = to;
+        TextWrapper::setOptions(*text_, o);
+    }
 
     bool        isText()   const override { return true; }
     std::string typeName() const override { return "Text"; }
+    const void* native()   const override { return text_; }
+    const sf::Drawable& drawable() const override { return *text_; }
 
 private:
+    using Dirty = utilities::DirtySet;
+
+    template<typename T>
+    void touch(Dirty::Kind kind, const T& before, const T& after) const {
+        Dirty::mark(text_, kind, before, after);
+    }
+
     sf::Text* text_;
 };
 
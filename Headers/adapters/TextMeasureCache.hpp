@@ -0,0 +1,107 @@
+#pragma once
+#include "../utilities/StringUtils.hpp"
+#include <SFML/Graphics/Font.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/Text.hpp>
+#include <cstdint>
+#include <cstring>
+#include <unordered_map>
+
+namespace adapters {
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  TextMeasureCache
+//
+//  Memoises sf::Text::getLocalBounds(), which makes SFML rebuild the glyph
+//  geometry of the whole string. Layout asks for the size of the same label
+//  several times per Style() call (context building, pass 2, flex), so every
+//  TextAdapter shares this one table.
+//
+//  Key: (string hash, string length, font, character size, style,
+//        letter spacing, line spacing, outline thickness)
+//
+//  There is no explicit invalidation — changing any of those inputs yields a
+//  different key. The table is dropped wholesale once it grows past
+//  kCapacity entries, and clear() should be called if a font that was used
+//  for measuring is destroyed while its address may be reused.
+// ─────────────────────────────────────────────────────────────────────────────
+
+struct TextMeasureCache {
+
+    static constexpr std::size_t kCapacity = 4096;
+
+    static sf::FloatRect localBounds(const sf::Text& text) {
+        const Key key = makeKey(text);
+        auto& table   = entries();
+
+        auto it = table.find(key);
+        if (it != table.end()) return it->second;
+
+        if (table.size() >= kCapacity) table.clear();
+        return table.emplace(key, text.getLocalBounds()).first->second;
+    }
+
+    static void clear() { entries().clear(); }
+
+    [[nodiscard]] static std::size_t size() { return entries().size(); }
+
+private:
+    struct Key {
+        std::uint64_t   stringHash;
+        std::size_t     length;
+        const sf::Font* font;
+        unsigned        characterSize;
+        std::uint32_t   style;
+        std::uint32_t   letterSpacing;     // float bit patterns — exact match
+        std::uint32_t   lineSpacing;
+        std::uint32_t   outlineThickness;
+
+        bool operator==(const Key& o) const {
+            return stringHash    == o.stringHash    && length      == o.length
+                && font          == o.font          && characterSize == o.characterSize
+                && style         == o.style         && letterSpacing == o.letterSpacing
+                && lineSpacing   == o.lineSpacing   && outlineThickness == o.outlineThickness;
+        }
+    };
+
+    struct KeyHash {
+        std::size_t operator()(const Key& k) const {
+            std::uint64_t h = k.stringHash;
+            auto mix = [&h](std::uint64_t v) { h ^= v + 0x9e3779b97f4a7c15ull + (h << 6) + (h >> 2); };
+            mix(reinterpret_cast<std::uintptr_t>(k.font));
+            mix(k.characterSize);
+            mix(k.style);
+            mix(k.letterSpacing);
+            mix(k.lineSpacing);
+            mix(k.outlineThickness);
+            return static_cast<std::size_t>(h);
+        }
+    };
+
+    static std::unordered_map<Key, sf::FloatRect, KeyHash>& entries() {
+        static std::unordered_map<Key, sf::FloatRect, KeyHash> table;
+        return table;
+    }
+
+    static std::uint32_t bits(float f) {
+        std::uint32_t u;
+        std::memcpy(&u, &f, sizeof u);
+        return u;
+    }
+
+    static Key makeKey(const sf::Text& text) {
+        const sf::String& s = text.getString();
+        return Key{
+            utilities::StringUtils::hash(s.getData(), s.getSize()),
+            s.getSize(),
+            &text.getFont(),
+            text.getCharacterSize(),
+            static_cast<std::uint32_t>(text.getStyle()),
+            bits(text.getLetterSpacing()),
+            bits(text.getLineSpacing()),
+            bits(text.getOutlineThickness())
+        };
+    }
+};
+
+} // namespace adapters
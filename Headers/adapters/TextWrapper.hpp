@@ -0,0 +1,140 @@
+#pragma once
+#include "../contracts/TextWrap.hpp"
+#include "../utilities/LineBreaker.hpp"
+#include "../utilities/StringUtils.hpp"
+#include "GlyphAdvanceCache.hpp"
+#include <SFML/Graphics/Text.hpp>
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <unordered_map>
+
+namespace adapters {
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  TextWrapper
+//
+//  Per-sf::Text wrapping state. TextAdapter instances are recreated on every
+//  Style() call, so the unwrapped source string, the wrap width and the
+//  white-space / overflow-wrap / text-overflow options live here, keyed by
+//  the sf::Text address.
+//
+//  The wrapped result is written back with setString(). A hash of that
+//  output is remembered; if the string no longer matches it, the caller has
+//  assigned new text and it becomes the new source.
+//
+//  Re-breaking only happens when the source text, width, options, font,
+//  character size, style or letter spacing actually changed.
+//
+//  setMinContent() wraps at the text's min-content width instead of a fixed
+//  one (width: min-content); it is measured again on every re-break, so it
+//  follows font, size and option changes until setWidth() is called.
+// ─────────────────────────────────────────────────────────────────────────────
+
+struct TextWrapper {
+
+    static void setWidth(sf::Text& text, float width) {
+        auto& st = state(text);
+        st.width      = std::max(0.f, width);
+        st.minContent = false;
+        reflow(text);
+    }
+
+    static void setMinContent(sf::Text& text) {
+        auto& st = state(text);
+        st.minContent = true;
+        reflow(text);
+    }
+
+    static void setOptions(sf::Text& text, const contracts::TextWrap& opts) {
+        auto& st = state(text);
+        st.opts = opts;
+        reflow(text);
+    }
+
+    [[nodiscard]] static contracts::TextWrap options(const sf::Text& text) {
+        auto it = states().find(&text);
+        return it != states().end() ? it->second.opts : contracts::TextWrap{};
+    }
+
+    // Re-breaks if anything that affects line breaks changed. No-op for
+    // texts that were never given a width or wrap option.
+    static void reflow(sf::Text& text) {
+        auto it = states().find(&text);
+        if (it == states().end()) return;
+        State& st = it->second;
+
+        const sf::String& current = text.getString();
+        const std::uint64_t currentHash =
+            utilities::StringUtils::hash(current.getData(), current.getSize());
+
+        bool dirty = false;
+        if (!st.hasOutput || currentHash != st.outputHash) {
+            st.source = current.toUtf32();
+            dirty = true;
+        }
+
+        const Layout layout{ st.minContent ? kMinContent : st.width, st.opts,
+                             &text.getFont(), text.getCharacterSize(),
+                             static_cast<std::uint32_t>(text.getStyle()),
+                             text.getLetterSpacing() };
+        if (!st.hasOutput || layout != st.layout) dirty = true;
+        if (!dirty) return;
+
+        auto& glyphs        = GlyphAdvanceCache::table(text.getFont(),
+                                                       text.getCharacterSize(),
+                                                       layout.style);
+        const float spacing = layout.letterSpacing;
+        auto advance = [&](char32_t prev, char32_t cur) { return glyphs.advance(prev, cur, spacing); };
+        const float width = st.minContent
+            ? utilities::LineBreaker::minContentWidth(st.source, st.opts, advance)
+            : st.width;
+        const std::u32string wrapped = utilities::LineBreaker::wrap(st.source, width, st.opts, advance);
+
+        text.setString(sf::String(wrapped));
+        st.outputHash = utilities::StringUtils::hash(wrapped.data(), wrapped.size());
+        st.layout     = layout;
+        st.hasOutput  = true;
+    }
+
+    // Drops the state for a text that is about to be destroyed; any other
+    // element has none
+    static void forget(const void* native) { states().erase(static_cast<const sf::Text*>(native)); }
+
+private:
+    static constexpr float kMinContent = -1.f;     // Layout::width while setMinContent()
+
+    struct Layout {
+        float               width         = 0.f;
+        contracts::TextWrap opts;
+        const sf::Font*     font          = nullptr;
+        unsigned            characterSize = 0;
+        std::uint32_t       style         = 0;
+        float               letterSpacing = 1.f;
+
+        bool operator!=(const Layout& o) const {
+            return width != o.width || opts != o.opts || font != o.font
+                || characterSize != o.characterSize || style != o.style
+                || letterSpacing != o.letterSpacing;
+        }
+    };
+
+    struct State {
+        std::u32string      source;
+        float               width = 0.f;
+        bool                minContent = false;
+        contracts::TextWrap opts;
+        Layout              layout;     // inputs of the last break
+        std::uint64_t       outputHash = 0;
+        bool                hasOutput  = false;
+    };
+
+    static std::unordered_map<const sf::Text*, State>& states() {
+        static std::unordered_map<const sf::Text*, State> map;
+        return map;
+    }
+
+    static State& state(const sf::Text& text) { return states()[&text]; }
+};
+
+} // namespace adapters
@@ -0,0 +1,28 @@
+#pragma once
+#include <array>
+
+namespace contracts {
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  BorderRadius — per-corner radii as declared, in CSS order
+//  (top-left, top-right, bottom-right, bottom-left).
+//
+//  Percentages stay unresolved until the element's size is known: a
+//  percentage corner is elliptical, x against the width and y against the
+//  height, as in CSS.
+// ─────────────────────────────────────────────────────────────────────────────
+struct BorderRadius {
+    enum Corner { TopLeft, TopRight, BottomRight, BottomLeft };
+
+    std::array<float, 4> value   { 0.f, 0.f, 0.f, 0.f };
+    std::array<bool,  4> percent { false, false, false, false };   // value is a fraction of 1
+
+    [[nodiscard]] bool empty() const {
+        return value[0] <= 0.f && value[1] <= 0.f && value[2] <= 0.f && value[3] <= 0.f;
+    }
+
+    bool operator==(const BorderRadius& o) const { return value == o.value && percent == o.percent; }
+    bool operator!=(const BorderRadius& o) const { return !(*this == o); }
+};
+
+} // namespace contracts
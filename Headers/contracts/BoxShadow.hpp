@@ -0,0 +1,28 @@
+#pragma once
+#include <SFML/Graphics/Color.hpp>
+
+namespace contracts {
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  BoxShadow — box-shadow: <x> <y> [<blur> [<spread>]] <color>, in px.
+//
+//  The shadow is the element's box (rounded corners included) grown by
+//  `spread`, offset by (x, y) and blurred with a gaussian of σ = blur / 2,
+//  as in CSS. A transparent color means no shadow.
+// ─────────────────────────────────────────────────────────────────────────────
+struct BoxShadow {
+    float     x      = 0.f;
+    float     y      = 0.f;
+    float     blur   = 0.f;
+    float     spread = 0.f;
+    sf::Color color  = sf::Color::Transparent;
+
+    [[nodiscard]] bool empty() const { return color.a == 0; }
+
+    bool operator==(const BoxShadow& o) const {
+        return x == o.x && y == o.y && blur == o.blur && spread == o.spread && color == o.color;
+    }
+    bool operator!=(const BoxShadow& o) const { return !(*this == o); }
+};
+
+} // namespace contracts
@@ -0,0 +1,56 @@
+#pragma once
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <vector>
+
+namespace contracts {
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  Gradient — a parsed linear-gradient() / radial-gradient() background.
+//
+//  Stop positions stay as declared (fraction of the gradient line, or px,
+//  or unset) because px stops and the line length both depend on the
+//  element's size; GradientMesh resolves them when it builds the mesh.
+// ─────────────────────────────────────────────────────────────────────────────
+struct GradientStop {
+    sf::Color color;
+    float     position = 0.f;
+    bool      hasPosition = false;   // "red" vs "red 40%"
+    bool      pixels      = false;   // position is px, not a fraction
+
+    bool operator==(const GradientStop& o) const {
+        return color == o.color && position == o.position
+            && hasPosition == o.hasPosition && pixels == o.pixels;
+    }
+};
+
+struct Gradient {
+    enum class Kind   { None, Linear, Radial };
+    enum class Shape  { Ellipse, Circle };
+    enum class Extent { FarthestCorner, ClosestSide, ClosestCorner, FarthestSide };
+
+    Kind   kind   = Kind::None;
+
+    // Linear: CSS angle, 0deg points up, 90deg to the right. "to top right"
+    // style corners depend on the box's aspect ratio, so they are kept as a
+    // direction ({±1, ±1}) and turned into an angle at build time.
+    float        angle  = 180.f;
+    sf::Vector2i corner { 0, 0 };
+
+    // Radial
+    Shape        shape  = Shape::Ellipse;
+    Extent       extent = Extent::FarthestCorner;
+    sf::Vector2f center { 0.5f, 0.5f };         // fraction of the box
+
+    std::vector<GradientStop> stops;
+
+    [[nodiscard]] bool empty() const { return kind == Kind::None || stops.empty(); }
+
+    bool operator==(const Gradient& o) const {
+        return kind == o.kind && angle == o.angle && corner == o.corner && shape == o.shape
+            && extent == o.extent && center == o.center && stops == o.stops;
+    }
+    bool operator!=(const Gradient& o) const { return !(*this == o); }
+};
+
+} // namespace contracts
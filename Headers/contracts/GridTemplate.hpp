@@ -0,0 +1,88 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+
+namespace contracts {
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  GridTrackSize — one sizing function of a track.
+//  Fixed lengths (px, vw, vh) are resolved when parsed; percentages are
+//  kept relative to the grid container's inner size.
+// ─────────────────────────────────────────────────────────────────────────────
+struct GridTrackSize {
+    enum class Kind { Fixed, Percent, Fr, Auto };
+
+    Kind  kind  = Kind::Auto;
+    float value = 0.f;          // px, fraction of 1 (Percent) or fr factor
+
+    bool operator==(const GridTrackSize& o) const { return kind == o.kind && value == o.value; }
+    bool operator!=(const GridTrackSize& o) const { return !(*this == o); }
+};
+
+// A track is minmax(min, max); a plain size uses the same value for both
+// (except "1fr", which is minmax(0, 1fr) here).
+struct GridTrack {
+    GridTrackSize min;
+    GridTrackSize max;
+
+    bool operator==(const GridTrack& o) const { return min == o.min && max == o.max; }
+    bool operator!=(const GridTrack& o) const { return !(*this == o); }
+};
+
+// Track list of grid-template-columns/rows. A repeat(auto-fill, ...) group
+// is kept aside and expanded at layout time, once the container size is
+// known; it is inserted before tracks[repeatAt].
+struct GridTrackList {
+    std::vector<GridTrack> tracks;
+    std::vector<GridTrack> autoRepeat;
+    std::size_t            repeatAt = 0;
+
+    [[nodiscard]] bool empty() const { return tracks.empty() && autoRepeat.empty(); }
+
+    bool operator==(const GridTrackList& o) const {
+        return tracks == o.tracks && autoRepeat == o.autoRepeat && repeatAt == o.repeatAt;
+    }
+    bool operator!=(const GridTrackList& o) const { return !(*this == o); }
+};
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  GridLine — placement of an item on one axis, parsed from grid-column /
+//  grid-row: "2", "2 / 4", "span 2", "1 / -1". Lines are 1-based, negative
+//  lines count back from the end of the explicit grid, 0 means auto.
+// ─────────────────────────────────────────────────────────────────────────────
+struct GridLine {
+    int start = 0;
+    int end   = 0;
+    int span  = 1;
+
+    bool operator==(const GridLine& o) const {
+        return start == o.start && end == o.end && span == o.span;
+    }
+    bool operator!=(const GridLine& o) const { return !(*this == o); }
+};
+
+struct GridPlacement {
+    GridLine column;
+    GridLine row;
+};
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  GridTemplate — container-side grid intent parsed from display: grid and
+//  the grid-template-* / grid-auto-* / gap / *-items properties.
+// ─────────────────────────────────────────────────────────────────────────────
+struct GridTemplate {
+    enum class Align { Start, End, Center, Stretch };
+
+    bool                   enabled    = false;
+    GridTrackList          columns;                 // explicit tracks
+    GridTrackList          rows;
+    GridTrack              autoColumns;             // implicit tracks (auto)
+    GridTrack              autoRows;
+    bool                   flowColumn = false;      // grid-auto-flow: column
+    float                  columnGap  = 0.f;
+    float                  rowGap     = 0.f;
+    Align                  justifyItems = Align::Start;
+    Align                  alignItems   = Align::Start;
+};
+
+} // namespace contracts
@@ -1,8 +1,15 @@
 #pragma once
 #include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/Drawable.hpp>
 #include <SFML/Graphics/Rect.hpp>
 #include <SFML/Graphics/Text.hpp>
+#include <SFML/Graphics/Transform.hpp>
 #include <SFML/System/Vector2.hpp>
+#include "./BorderRadius.hpp"
+#include "./BoxShadow.hpp"
+#include "./Gradient.hpp"
+#include "./NineSlice.hpp"
+#include "./TextWrap.hpp"
 #include <string>
 
 namespace contracts {
@@ -32,6 +39,17 @@ public:
     [[nodiscard]] virtual sf::FloatRect getBounds()   const = 0;
     [[nodiscard]] virtual sf::Vector2f  getOrigin()   const = 0;
     [[nodiscard]] virtual sf::Vector2f  getScale()    const = 0;
+    [[nodiscard]] virtual float         getRotation() const = 0;   // degrees
+    [[nodiscard]] virtual sf::Transform getTransform() const = 0;
+
+    // What drawing the element touches, in local coordinates — the bounds
+    // plus anything painted outside them (box-shadow)
+    [[nodiscard]] virtual sf::FloatRect getVisualBounds() const { return getBounds(); }
+
+    // Bounds after position/rotation/scale/origin — an axis-aligned box
+    [[nodiscard]] sf::FloatRect getGlobalBounds() const {
+        return getTransform().transformRect(getBounds());
+    }
 
     // ── Geometry mutations ─────────────────────────────────────────────────
     virtual void setPosition(sf::Vector2f pos)  = 0;
@@ -50,17 +68,54 @@ public:
     virtual void      setOutlineThickness(float t)     = 0;
     [[nodiscard]]
     virtual sf::Color getFillColor()               const = 0;
+    [[nodiscard]]
+    virtual sf::Color getOutlineColor()            const { return sf::Color::Transparent; }
+    [[nodiscard]]
+    virtual float     getOutlineThickness()        const { return 0.f; }
+
+    // Rounded corners — only rectangles act on it (no-op elsewhere)
+    virtual void setBorderRadius(const BorderRadius& /*radius*/) {}
+    [[nodiscard]]
+    virtual BorderRadius getBorderRadius()         const { return {}; }
+
+    // Blurred shadow drawn under the element — shapes only; empty clears it
+    virtual void setBoxShadow(const BoxShadow& /*shadow*/) {}
+
+    // Gradient background over the fill — shapes only; empty gradient clears it
+    virtual void setBackgroundGradient(const Gradient& /*gradient*/) {}
+
+    // Image file shown by the element (sprite texture / shape fill texture);
+    // an empty path clears it where the element allows
+    virtual void setBackgroundImage(const std::string& /*path*/) {}
+
+    // border-image slicing — sprites only; an empty slice turns it off
+    virtual void setNineSlice(const NineSlice& /*slice*/) {}
+    [[nodiscard]]
+    virtual NineSlice getNineSlice()               const { return {}; }
 
     // ── Text-only mutations (no-op on non-text adapters) ──────────────────
     virtual void setCharacterSize(unsigned /*size*/)         {}
     virtual void setLetterSpacing(float /*factor*/)          {}
     virtual void setLineSpacing  (float /*factor*/)          {}
     virtual void setTextStyle    (sf::Text::Style /*style*/) {}
+    virtual void setFontFamily   (const std::string& /*families*/) {}
+    virtual void setWhiteSpace   (TextWrap::WhiteSpace)      {}
+    virtual void setOverflowWrap (TextWrap::OverflowWrap)    {}
+    virtual void setTextOverflow (TextWrap::TextOverflow)    {}
+    // Wraps at the widest word (width: min-content) until the next setSize()
+    virtual void wrapToMinContent()                          {}
 
     // ── Type discriminators ────────────────────────────────────────────────
     [[nodiscard]] virtual bool        isText()    const { return false; }
     [[nodiscard]] virtual bool        isSprite()  const { return false; }
     [[nodiscard]] virtual std::string typeName()  const = 0;
+
+    // Address of the wrapped SFML object — the element's identity, shared by
+    // every adapter created for it.
+    [[nodiscard]] virtual const void* native() const = 0;
+
+    // The wrapped SFML object, for drawing it in paint order
+    [[nodiscard]] virtual const sf::Drawable& drawable() const = 0;
 };
 
 } // namespace contracts
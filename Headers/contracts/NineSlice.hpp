@@ -0,0 +1,35 @@
+#pragma once
+#include <array>
+
+namespace contracts {
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  NineSlice — border-image-slice / border-image-width as declared, in CSS
+//  side order (top, right, bottom, left).
+//
+//  slice:  insets into the texture rect, in texture pixels or (percent) a
+//          fraction of its width/height.
+//  width:  how wide each border is drawn. A px value, or (multiple) a
+//          factor of the slice — the CSS default of 1 draws corners 1:1.
+// ─────────────────────────────────────────────────────────────────────────────
+struct NineSlice {
+    enum Side { Top, Right, Bottom, Left };
+
+    std::array<float, 4> slice         { 0.f, 0.f, 0.f, 0.f };
+    std::array<bool,  4> slicePercent  { false, false, false, false };
+    std::array<float, 4> width         { 1.f, 1.f, 1.f, 1.f };
+    std::array<bool,  4> widthMultiple { true, true, true, true };
+    bool                 fill = false;      // draw the middle patch
+
+    [[nodiscard]] bool empty() const {
+        return slice[0] <= 0.f && slice[1] <= 0.f && slice[2] <= 0.f && slice[3] <= 0.f && !fill;
+    }
+
+    bool operator==(const NineSlice& o) const {
+        return slice == o.slice && slicePercent == o.slicePercent && width == o.width
+            && widthMultiple == o.widthMultiple && fill == o.fill;
+    }
+    bool operator!=(const NineSlice& o) const { return !(*this == o); }
+};
+
+} // namespace contracts
@@ -0,0 +1,42 @@
+#pragma once
+
+namespace contracts {
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  TextWrap — wrapping intent parsed from white-space / overflow-wrap /
+//  text-overflow. Only text adapters act on it.
+// ─────────────────────────────────────────────────────────────────────────────
+struct TextWrap {
+    enum class WhiteSpace {
+        Normal,     // collapse spaces and newlines, wrap
+        NoWrap,     // collapse spaces and newlines, never wrap
+        Pre,        // preserve everything, break only at '\n'
+        PreWrap,    // preserve everything, wrap
+        PreLine,    // collapse spaces, preserve '\n', wrap
+    };
+    enum class OverflowWrap {
+        Normal,     // break only at spaces — long words overflow
+        BreakWord,  // break inside a word when it alone overflows the line
+    };
+    enum class TextOverflow {
+        Clip,
+        Ellipsis,   // truncate overflowing lines with "…"
+    };
+
+    WhiteSpace   whiteSpace   = WhiteSpace::Normal;
+    OverflowWrap overflowWrap = OverflowWrap::Normal;
+    TextOverflow textOverflow = TextOverflow::Clip;
+
+    [[nodiscard]] bool wraps() const {
+        return whiteSpace != WhiteSpace::NoWrap && whiteSpace != WhiteSpace::Pre;
+    }
+
+    bool operator==(const TextWrap& o) const {
+        return whiteSpace   == o.whiteSpace
+            && overflowWrap == o.overflowWrap
+            && textOverflow == o.textOverflow;
+    }
+    bool operator!=(const TextWrap& o) const { return !(*this == o); }
+};
+
+} // namespace contracts
@@ -4,7 +4,10 @@
 #include <optional>
 #include <memory>
 #include <array>
+#include <cstdint>
+#include <limits>
 #include "./IStyleable.hpp"
+#include "./GridTemplate.hpp"
 #include <SFML/System/Vector2.hpp>
 
 namespace contracts {
@@ -42,6 +45,42 @@ struct Declaration {
     std::string value;      // trimmed raw value string
 };
 
+// ─────────────────────────────────────────────────────────────────────────────
+//  ElementState — pseudo-class flags. Combined as a bit mask; when several
+//  are active, higher bits win (hover < focus < active < disabled).
+// ─────────────────────────────────────────────────────────────────────────────
+enum class ElementState : std::uint8_t {
+    None     = 0,
+    Hover    = 1 << 0,
+    Focus    = 1 << 1,
+    Active   = 1 << 2,
+    Disabled = 1 << 3,
+};
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  StateBlock — declarations that apply only while a state is active:
+//  ":hover { background-color: #89b4fa; border-width: 2px }"
+// ─────────────────────────────────────────────────────────────────────────────
+struct StateBlock {
+    ElementState             state = ElementState::None;
+    std::vector<Declaration> decls;
+};
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  PaintStyle — the properties a state change can apply without layout
+// ─────────────────────────────────────────────────────────────────────────────
+struct PaintStyle {
+    sf::Color fill;
+    sf::Color outline;
+    float     outlineThickness = 0.f;
+
+    bool operator==(const PaintStyle& o) const {
+        return fill == o.fill && outline == o.outline
+            && outlineThickness == o.outlineThickness;
+    }
+    bool operator!=(const PaintStyle& o) const { return !(*this == o); }
+};
+
 // ─────────────────────────────────────────────────────────────────────────────
 //  BoxModel — resolved padding and margin values
 // ─────────────────────────────────────────────────────────────────────────────
@@ -68,6 +107,7 @@ struct BoxModel {
 struct FlexLayout {
     bool enabled = false;
     bool column  = false;   // true → flex-direction: column
+    bool wrap    = false;   // true → flex-wrap: wrap
     float gap    = 0.f;
 
     enum class Justify {
@@ -82,6 +122,37 @@ struct FlexLayout {
     Align   align   = Align::Start;
 };
 
+// ─────────────────────────────────────────────────────────────────────────────
+//  FlexItem — flex-grow / flex-shrink / flex-basis declared on a child
+// ─────────────────────────────────────────────────────────────────────────────
+struct FlexItem {
+    float                grow         = 0.f;
+    float                shrink       = 1.f;
+    std::optional<float> basis;                 // px or %; nullopt → auto (the item's size)
+    bool                 basisPercent = false;  // basis is a % of the container's inner main size
+};
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  ContentSizing — width / height keywords sized from the element's content:
+//  its children for containers, its text for texts
+// ─────────────────────────────────────────────────────────────────────────────
+struct ContentSizing {
+    enum class Keyword { None, Auto, FitContent, MinContent, MaxContent };
+
+    Keyword width  = Keyword::None;
+    Keyword height = Keyword::None;
+
+    [[nodiscard]] bool any() const { return width != Keyword::None || height != Keyword::None; }
+};
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  SizeLimits — min-/max-width and -height, px, as declared on an element
+// ─────────────────────────────────────────────────────────────────────────────
+struct SizeLimits {
+    sf::Vector2f min{ 0.f, 0.f };
+    sf::Vector2f max{ std::numeric_limits<float>::infinity(), std::numeric_limits<float>::infinity() };
+};
+
 // ─────────────────────────────────────────────────────────────────────────────
 //  PositionMode — how the element is positioned relative to its container
 // ─────────────────────────────────────────────────────────────────────────────
@@ -111,6 +182,12 @@ struct StyleContext {
     // Flex layout intent (filled during pass 1)
     FlexLayout flex;
 
+    // Grid layout intent (filled during pass 1)
+    GridTemplate grid;
+
+    // width / height keywords (filled during pass 1, resolved by ContentSize)
+    ContentSizing content;
+
     // Positioning mode (filled during pass 1, consumed in pass 2)
     PositionMode positionMode = PositionMode::Default;
 
@@ -0,0 +1,333 @@
+#pragma once
+#include "../adapters/LayoutProxy.hpp"
+#include "../contracts/Types.hpp"
+#include "../utilities/Trace.hpp"
+#include "../utilities/TripleBuffer.hpp"
+#include "../utilities/WorkerPool.hpp"
+#include "ContentSize.hpp"
+#include "ElementRegistry.hpp"
+#include "FlexLayout.hpp"
+#include "GridLayout.hpp"
+#include "StyleEngine.hpp"
+#include <SFML/Graphics/RenderWindow.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace core {
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  AsyncLayout
+//
+//  Lays containers out on a background thread (CSS::submit / applyLayout):
+//
+//    submit()   render thread — styles the container as Style() would
+//               (parse, var(), dispatch, bookkeeping) but leaves content
+//               sizing and flex/grid for later; submitting the same
+//               container again before it went out replaces the request
+//    pump()     render thread, once per frame — copies the newest finished
+//               frame onto the elements, then hands everything submitted
+//               since to the worker as one batch of LayoutProxy copies
+//    worker     runs ContentSize and FlexLayout / GridLayout on the copies
+//               and publishes the resulting rects as a frame
+//
+//  Frames travel through a TripleBuffer, so the worker never waits for the
+//  render thread to read one and the render thread never waits for the
+//  worker: a frame not finished yet is simply picked up by a later pump().
+//  One batch is out at a time; submissions meanwhile wait for the next.
+//
+//  Style resolution stays on the render thread: dispatch loads fonts and
+//  textures, which SFML only allows there. What moves is the layout — the
+//  part that grows with the number of children.
+//
+//  The worker keeps its own FlexLayout / GridLayout state; each batch
+//  carries copies of the intent styling recorded (flex-*, min-/max-*,
+//  grid placement), what FlexLayout remembers of each child (its own size,
+//  its position before a padding offset) and the elements forgotten since
+//  the last one. The frame carries the remembered sizes and positions
+//  back, so a later synchronous relayout starts from the same state a
+//  synchronous layout would have left. Elements a batch lays out that were
+//  never styled before are not drawn until its frame was applied. Texts
+//  are placed at the size they had when the batch went out; the width a
+//  layout gives them wraps them when applied.
+// ─────────────────────────────────────────────────────────────────────────────
+
+struct AsyncLayout {
+
+    static void submit(
+        contracts::Styleable                self,
+        const std::vector<std::string>&     rules,
+        std::optional<contracts::Styleable> parent,
+        contracts::StyleableList            children,
+        sf::RenderWindow&                   window
+    ) {
+        CSS_TRACE_ZONE("AsyncLayout::submit");
+        auto& s = state();
+        const void* native = self->native();
+
+        std::vector<const void*> hides;
+        auto hideNew = [&](const contracts::Styleable& el) {
+            if (ElementRegistry::find(el->native()) != ElementRegistry::kInvalid) return;
+            hides.push_back(el->native());
+            ++s.hidden[el->native()];
+        };
+        hideNew(self);
+        for (const auto& child : children) hideNew(child);
+
+        const sf::Vector2f before = self->getSize();
+        contracts::StyleContext ctx = StyleEngine::styleDeferred(self, rules, std::move(parent), &children, window);
+
+        const auto it = std::find_if(s.pending.begin(), s.pending.end(),
+                                     [native](const Request& r) { return r.self->native() == native; });
+        if (it == s.pending.end()) {
+            s.pending.push_back({ std::move(self), std::move(children), std::move(ctx), before, std::move(hides) });
+            return;
+        }
+        it->children = std::move(children);
+        it->ctx      = std::move(ctx);
+        it->hides.insert(it->hides.end(), hides.begin(), hides.end());
+    }
+
+    // Applies the newest finished frame, then sends what was submitted
+    // since; true when a frame was applied
+    static bool pump(sf::RenderWindow& window) {
+        CSS_TRACE_ZONE("AsyncLayout::pump");
+        auto& s = state();
+        bool applied = false;
+        if (s.busy && s.frames.fetch()) {
+            apply(s.frames.front(), window);
+            s.busy  = false;
+            applied = true;
+        }
+        if (!s.busy && !s.pending.empty()) send();
+        return applied;
+    }
+
+    // Nothing submitted, nothing out
+    [[nodiscard]] static bool idle() {
+        const auto& s = state();
+        return !s.busy && s.pending.empty();
+    }
+
+    // Laid out by a batch whose frame wasn't applied yet, never styled before
+    [[nodiscard]] static bool hidden(const void* native) {
+        const auto& h = state().hidden;
+        return !h.empty() && h.find(native) != h.end();
+    }
+
+    static void forget(const void* native) {
+        auto& s = state();
+        if (s.pool) s.forgotten.push_back(native);
+        if (s.pending.empty() && !s.busy) return;
+
+        s.pending.erase(std::remove_if(s.pending.begin(), s.pending.end(),
+                                       [&](Request& r) {
+                                           if (r.self->native() != native) return false;
+                                           unhide(r.hides);
+                                           return true;
+                                       }),
+                        s.pending.end());
+        for (Request& r : s.pending)
+            r.children.erase(std::remove_if(r.children.begin(), r.children.end(),
+                                            [native](const contracts::Styleable& c) { return c->native() == native; }),
+                             r.children.end());
+
+        // Out already: keep the slot, skip it when the frame comes back
+        for (Request& r : s.inflight) {
+            if (r.self.valid() && r.self->native() == native) r.self = {};
+            for (auto& c : r.children)
+                if (c.valid() && c->native() == native) c = {};
+        }
+        s.hidden.erase(native);
+    }
+
+private:
+    struct Request {
+        contracts::Styleable     self;
+        contracts::StyleableList children;
+        contracts::StyleContext  ctx;
+        sf::Vector2f             before;    // self's size before it was first submitted
+        std::vector<const void*> hides;
+    };
+
+    // Styling intent of one element, copied for the worker
+    struct Intent {
+        std::optional<contracts::FlexItem>      flex;
+        std::optional<contracts::SizeLimits>    limits;
+        std::optional<contracts::GridPlacement> placement;
+        std::optional<FlexLayout::Natural>      natural;
+        std::optional<FlexLayout::Offset>       offset;
+    };
+
+    struct Task {
+        contracts::StyleContext  ctx;       // self is a LayoutProxy
+        contracts::StyleableList children;  // LayoutProxies
+        std::vector<Intent>      intents;   // self, then each child
+    };
+
+    struct Batch {
+        std::vector<Task>        tasks;
+        std::vector<const void*> forgotten;
+    };
+
+    // Geometry of self then each child of every task, in batch order
+    struct Placed {
+        sf::Vector2f                      position;
+        std::optional<sf::Vector2f>       size;     // requested by the layout
+        std::optional<sf::Vector2f>       natural;  // own size, children of a flex layout
+        std::optional<FlexLayout::Offset> offset;   // children offset by padding
+    };
+
+    struct Frame {
+        std::vector<Placed> placed;
+    };
+
+    // The pool is declared last so it joins before the frames it writes to
+    // are destroyed; it starts with the first batch
+    struct State {
+        std::vector<Request>                          pending;
+        std::vector<Request>                          inflight;
+        std::vector<const void*>                      forgotten;
+        std::unordered_map<const void*, std::size_t>  hidden;
+        bool                                          busy = false;
+        utilities::TripleBuffer<Frame>                frames;
+        std::unique_ptr<utilities::WorkerPool>        pool;
+    };
+
+    static State& state() {
+        static State s;
+        return s;
+    }
+
+    static void unhide(const std::vector<const void*>& hides) {
+        auto& h = state().hidden;
+        for (const void* native : hides) {
+            const auto it = h.find(native);
+            if (it != h.end() && --it->second == 0) h.erase(it);
+        }
+    }
+
+    static Intent intent(const void* native) {
+        Intent in;
+        if (const auto* f = FlexLayout::findItem(native))      in.flex      = *f;
+        if (const auto* l = FlexLayout::findLimits(native))    in.limits    = *l;
+        if (const auto* p = GridLayout::findPlacement(native)) in.placement = *p;
+        if (const auto* n = FlexLayout::findNatural(native))   in.natural   = *n;
+        if (const auto* o = FlexLayout::findOffset(native))    in.offset    = *o;
+        return in;
+    }
+
+    static contracts::Styleable proxy(const contracts::Styleable& el) {
+        return contracts::Styleable(std::make_shared<adapters::LayoutProxy>(*el));
+    }
+
+    // ── Render thread ─────────────────────────────────────────────────────
+
+    static void send() {
+        CSS_TRACE_ZONE("AsyncLayout::send");
+        auto& s = state();
+        auto batch = std::make_shared<Batch>();
+        batch->forgotten.swap(s.forgotten);
+        batch->tasks.reserve(s.pending.size());
+        for (const Request& r : s.pending) {
+            Task t;
+            t.ctx      = r.ctx;
+            t.ctx.self = proxy(r.self);
+            t.intents.reserve(r.children.size() + 1);
+            t.intents.push_back(intent(r.self->native()));
+            t.children.reserve(r.children.size());
+            for (const auto& child : r.children) {
+                t.children.push_back(proxy(child));
+                t.intents.push_back(intent(child->native()));
+            }
+            batch->tasks.push_back(std::move(t));
+        }
+        s.inflight.swap(s.pending);
+        s.pending.clear();
+        s.busy = true;
+
+        if (!s.pool) s.pool = std::make_unique<utilities::WorkerPool>(1);
+        auto& frames = s.frames;
+        s.pool->submit([batch, &frames] {
+            layOut(*batch, frames.back());
+            frames.publish();
+        });
+    }
+
+    static void apply(const Frame& frame, sf::RenderWindow& window) {
+        CSS_TRACE_ZONE("AsyncLayout::apply");
+        auto& s = state();
+        std::size_t k = 0;
+        for (Request& r : s.inflight) {
+            const Placed& self = frame.placed[k++];
+            const bool live = r.self.valid();
+            if (live && self.size && *self.size != r.self->getSize()) r.self->setSize(*self.size);
+            for (const auto& child : r.children) {
+                const Placed& p = frame.placed[k++];
+                if (!live || !child.valid()) continue;
+                if (p.size && *p.size != child->getSize()) child->setSize(*p.size);
+                if (p.position != child->getPosition()) child->setPosition(p.position);
+                if (p.natural) FlexLayout::assume(child->native(), *p.natural, child->getSize());
+                if (p.offset)  FlexLayout::adopt(child->native(), p.offset);
+            }
+            unhide(r.hides);
+            if (!live) continue;
+
+            for (const auto& child : r.children)
+                if (child.valid()) ElementRegistry::track(child);
+            const ElementRegistry::Id id = ElementRegistry::track(r.self);
+            if (id != ElementRegistry::kInvalid) StyleEngine::resized(id, r.before, window);
+        }
+        s.inflight.clear();
+    }
+
+    // ── Worker thread ─────────────────────────────────────────────────────
+
+    static void layOut(Batch& batch, Frame& out) {
+        CSS_TRACE_ZONE("AsyncLayout::layOut");
+        for (const void* native : batch.forgotten) {
+            FlexLayout::forget(native);
+            GridLayout::forget(native);
+        }
+
+        out.placed.clear();
+        for (Task& t : batch.tasks) {
+            adopt(t.ctx.self->native(), t.intents[0]);
+            for (std::size_t i = 0; i < t.children.size(); ++i)
+                adopt(t.children[i]->native(), t.intents[i + 1]);
+
+            ContentSize::apply(t.ctx, t.children);
+            if (t.ctx.grid.enabled) GridLayout::apply(t.ctx, t.children);
+            else                    FlexLayout::apply(t.ctx, t.children);
+
+            out.placed.push_back(placed(*t.ctx.self));
+            for (const auto& child : t.children) {
+                Placed p = placed(*child);
+                const void* native = child->native();
+                if (!t.ctx.grid.enabled && t.ctx.flex.enabled) {
+                    const auto* n = FlexLayout::findNatural(native);
+                    p.natural = n ? n->size : child->getSize();
+                } else if (!t.ctx.grid.enabled) {
+                    if (const auto* o = FlexLayout::findOffset(native)) p.offset = *o;
+                }
+                out.placed.push_back(std::move(p));
+            }
+        }
+    }
+
+    static void adopt(const void* native, const Intent& in) {
+        FlexLayout::adopt(native, in.flex, in.limits, in.natural, in.offset);
+        GridLayout::adopt(native, in.placement);
+    }
+
+    static Placed placed(const contracts::IStyleable& el) {
+        const auto& proxy = static_cast<const adapters::LayoutProxy&>(el);
+        return { proxy.getPosition(), proxy.requested(), std::nullopt, std::nullopt };
+    }
+};
+
+} // namespace core
@@ -0,0 +1,82 @@
+#pragma once
+#include "../contracts/Types.hpp"
+#include "../utilities/Trace.hpp"
+#include "FlexLayout.hpp"
+#include "GridLayout.hpp"
+#include <algorithm>
+#include <limits>
+
+namespace core {
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  ContentSize
+//
+//  Resolves width / height keywords of a container from its children,
+//  before the container lays them out:
+//
+//    max-content   everything on one line (flex) / every track at its
+//                  content size (grid)
+//    min-content   the narrowest the content gets: a wrapping flex row puts
+//                  each item on its own line
+//    fit-content   max-content, shrunk to the containing block's width but
+//                  never below min-content
+//    auto          fit-content — elements are positioned, not in a flow,
+//                  so auto shrinks to fit like an absolutely positioned box
+//
+//  Heights are measured at the resolved width, so a wrapping row grows as
+//  many lines as that width needs. Both axes add the padding and respect
+//  min-/max-width and -height. Other containers are as large as their
+//  largest child. Children contribute their own size (not a size a previous
+//  flex pass gave them), so laying out again is stable.
+//
+//  The measurements are cached by the layouts, keyed by the children's
+//  sizes; StyleEngine re-measures a container only when one of its
+//  children changed size, and walks up while sizes keep changing.
+// ─────────────────────────────────────────────────────────────────────────────
+
+struct ContentSize {
+    using Keyword = contracts::ContentSizing::Keyword;
+
+    static void apply(const contracts::StyleContext& ctx, const contracts::StyleableList& children) {
+        const auto& c = ctx.content;
+        if (!c.any()) return;
+        CSS_TRACE_ZONE("ContentSize::apply");
+
+        const sf::Vector2f pad{ ctx.box.paddingLeft + ctx.box.paddingRight,
+                                ctx.box.paddingTop  + ctx.box.paddingBottom };
+        sf::Vector2f size = ctx.self->getSize();
+
+        if (c.width != Keyword::None) {
+            const float most  = measure(ctx, children, std::numeric_limits<float>::infinity()).x;
+            const float least = measure(ctx, children, 0.f).x;
+            float w = most;
+            if (c.width == Keyword::MinContent)      w = least;
+            else if (c.width != Keyword::MaxContent) w = std::min(most, std::max(least, ctx.parentSize.x - pad.x));
+            size.x = w + pad.x;
+        }
+        if (c.height != Keyword::None)
+            size.y = measure(ctx, children, std::max(0.f, size.x - pad.x)).y + pad.y;
+
+        if (const contracts::SizeLimits* lim = FlexLayout::findLimits(ctx.self->native())) {
+            size.x = std::max(lim->min.x, std::min(size.x, lim->max.x));
+            size.y = std::max(lim->min.y, std::min(size.y, lim->max.y));
+        }
+        if (size != ctx.self->getSize()) ctx.self->setSize(size);
+    }
+
+    // Content box of the children, rows `availWidth` wide
+    static sf::Vector2f measure(const contracts::StyleContext& ctx,
+                                const contracts::StyleableList& children, float availWidth) {
+        if (ctx.grid.enabled) return GridLayout::measure(ctx, children);
+        if (ctx.flex.enabled) return FlexLayout::measure(ctx, children, availWidth);
+
+        sf::Vector2f size{ 0.f, 0.f };
+        for (const auto& child : children) {
+            const sf::Vector2f s = child->getSize();
+            size = { std::max(size.x, s.x), std::max(size.y, s.y) };
+        }
+        return size;
+    }
+};
+
+} // namespace core
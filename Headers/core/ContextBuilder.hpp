@@ -1,5 +1,6 @@
 #pragma once
 #include "../contracts/Types.hpp"
+#include "../utilities/Trace.hpp"
 #include <SFML/Graphics/RenderWindow.hpp>
 #include <optional>
 
@@ -21,6 +22,7 @@ struct ContextBuilder {
 
     static contracts::StyleContext build(contracts::Styleable& self, std::optional<contracts::Styleable>& parent, sf::RenderWindow& window)
     {
+        CSS_TRACE_ZONE("ContextBuilder::build");
         contracts::StyleContext ctx;
         ctx.self       = self;
         ctx.windowSize = sf::Vector2f(window.getSize());
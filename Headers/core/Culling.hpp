@@ -0,0 +1,110 @@
+#pragma once
+#include <SFML/Graphics/Rect.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace core {
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  BoxArrays — axis-aligned boxes stored as four contiguous float arrays
+//  (structure of arrays), indexed by element id.
+//
+//  An "empty" slot is inverted (+inf .. -inf) so it never overlaps
+//  anything; an "unbounded" slot covers the whole plane.
+// ─────────────────────────────────────────────────────────────────────────────
+struct BoxArrays {
+    std::vector<float> minX, minY, maxX, maxY;
+
+    [[nodiscard]] std::size_t size() const { return minX.size(); }
+
+    void resize(std::size_t n) {
+        constexpr float inf = std::numeric_limits<float>::infinity();
+        minX.resize(n, inf);  minY.resize(n, inf);
+        maxX.resize(n, -inf); maxY.resize(n, -inf);
+    }
+
+    void set(std::size_t i, const sf::FloatRect& r) {
+        if (i >= size()) resize(i + 1);
+        minX[i] = r.position.x;            minY[i] = r.position.y;
+        maxX[i] = r.position.x + r.size.x; maxY[i] = r.position.y + r.size.y;
+    }
+
+    void setEmpty(std::size_t i) {
+        constexpr float inf = std::numeric_limits<float>::infinity();
+        if (i >= size()) resize(i + 1);
+        minX[i] = minY[i] = inf;
+        maxX[i] = maxY[i] = -inf;
+    }
+
+    void setUnbounded(std::size_t i) {
+        constexpr float inf = std::numeric_limits<float>::infinity();
+        if (i >= size()) resize(i + 1);
+        minX[i] = minY[i] = -inf;
+        maxX[i] = maxY[i] = inf;
+    }
+
+    [[nodiscard]] sf::FloatRect rect(std::size_t i) const {
+        return { { minX[i], minY[i] }, { maxX[i] - minX[i], maxY[i] - minY[i] } };
+    }
+
+    void clear() { minX.clear(); minY.clear(); maxX.clear(); maxY.clear(); }
+};
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  Culling
+//
+//  One branch-free pass over BoxArrays: an element is visible when its box
+//  overlaps both the view rect and its clip rect, and partially clipped
+//  when it is visible but sticks out of its clip rect. The loop body is
+//  plain min/max/compare on contiguous floats, so compilers vectorise it.
+// ─────────────────────────────────────────────────────────────────────────────
+struct Culling {
+
+    static void pass(
+        const BoxArrays&           boxes,
+        const BoxArrays&           clips,
+        const sf::FloatRect&       view,
+        std::vector<std::uint8_t>& visible,
+        std::vector<std::uint8_t>& partial
+    ) {
+        const std::size_t n = boxes.size();
+        visible.resize(n);
+        partial.resize(n);
+
+        kernel(n,
+               boxes.minX.data(), boxes.minY.data(), boxes.maxX.data(), boxes.maxY.data(),
+               clips.minX.data(), clips.minY.data(), clips.maxX.data(), clips.maxY.data(),
+               view.position.x, view.position.y,
+               view.position.x + view.size.x, view.position.y + view.size.y,
+               visible.data(), partial.data());
+    }
+
+private:
+    // Outputs are byte arrays, which may alias anything — __restrict tells
+    // the compiler they don't, otherwise the loop stays scalar.
+    static void kernel(
+        std::size_t n,
+        const float* bx0, const float* by0, const float* bx1, const float* by1,
+        const float* cx0, const float* cy0, const float* cx1, const float* cy1,
+        float vx0, float vy0, float vx1, float vy1,
+        std::uint8_t* __restrict vis,
+        std::uint8_t* __restrict par
+    ) {
+        for (std::size_t i = 0; i < n; ++i) {
+            const float x0 = cx0[i] > vx0 ? cx0[i] : vx0;
+            const float x1 = cx1[i] < vx1 ? cx1[i] : vx1;
+            const float y0 = cy0[i] > vy0 ? cy0[i] : vy0;
+            const float y1 = cy1[i] < vy1 ? cy1[i] : vy1;
+
+            const bool overlaps = (bx1[i] > x0) & (bx0[i] < x1) & (by1[i] > y0) & (by0[i] < y1);
+            const bool outside  = (bx0[i] < cx0[i]) | (bx1[i] > cx1[i])
+                                | (by0[i] < cy0[i]) | (by1[i] > cy1[i]);
+            vis[i] = static_cast<std::uint8_t>(overlaps);
+            par[i] = static_cast<std::uint8_t>(overlaps & outside);
+        }
+    }
+};
+
+} // namespace core
@@ -0,0 +1,171 @@
+#pragma once
+#include "../utilities/DirtySet.hpp"
+#include "../utilities/Trace.hpp"
+#include "ElementRegistry.hpp"
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/Transform.hpp>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+namespace core {
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  Damage
+//
+//  Turns the DirtySet marks left by adapter setters into the areas that
+//  must be redrawn: for each marked element, where it was last drawn and
+//  where it is now (visual bounds, clipped by overflow: hidden ancestors);
+//  for each forgotten element, where it was. An element only moved back to
+//  where it was drawn (geometry marks, same transform and bounds) is no
+//  damage. commit() — run by CSS::drawAll — records the marked elements as
+//  drawn and clears the marks.
+//
+//  merge() is pure and needs no window: rects are snapped outward to whole
+//  units, overlapping or touching ones are combined until all are disjoint,
+//  then the pair wasting the least area is combined until at most maxRects
+//  remain.
+// ─────────────────────────────────────────────────────────────────────────────
+
+struct Damage {
+    static constexpr std::size_t kMaxRects = 8;
+    static constexpr std::size_t kMaxInput = 256;      // more → one bounding rect
+
+    // Anything to redraw since the last commit()
+    [[nodiscard]] static bool pending() {
+        if (!state().removed.empty()) return true;
+        if (utilities::DirtySet::empty()) return false;
+        return !collect(1).empty();
+    }
+
+    // Damaged areas in world coordinates, merged
+    [[nodiscard]] static std::vector<sf::FloatRect> collect(std::size_t maxRects = kMaxRects) {
+        CSS_TRACE_ZONE("Damage::collect");
+        auto& s = state();
+        std::vector<sf::FloatRect> rects = s.removed;
+        for (const auto& [native, kinds] : utilities::DirtySet::all()) {
+            const ElementRegistry::Id id = ElementRegistry::find(native);
+            if (id == ElementRegistry::kInvalid) continue;       // never drawn by drawAll
+            const Snapshot now = snapshot(id);
+            auto it = s.drawn.find(native);
+            if (it != s.drawn.end()) {
+                if (kinds == utilities::DirtySet::Geometry && it->second == now) continue;
+                rects.push_back(it->second.world);
+            }
+            rects.push_back(now.world);
+        }
+        return merge(std::move(rects), maxRects);
+    }
+
+    static void commit() {
+        auto& s = state();
+        for (const auto& entry : utilities::DirtySet::all()) {
+            const ElementRegistry::Id id = ElementRegistry::find(entry.first);
+            if (id != ElementRegistry::kInvalid) s.drawn[entry.first] = snapshot(id);
+        }
+        s.removed.clear();
+        utilities::DirtySet::clear();
+    }
+
+    // The element's last drawn area becomes damage
+    static void forget(const void* native) {
+        auto& s = state();
+        auto it = s.drawn.find(native);
+        if (it != s.drawn.end()) {
+            s.removed.push_back(it->second.world);
+            s.drawn.erase(it);
+        }
+        utilities::DirtySet::erase(native);
+    }
+
+    static std::vector<sf::FloatRect> merge(std::vector<sf::FloatRect> rects, std::size_t maxRects = kMaxRects) {
+        std::vector<sf::FloatRect> out;
+        out.reserve(rects.size());
+        for (const auto& r : rects) {
+            if (!(r.size.x > 0.f && r.size.y > 0.f)) continue;
+            const float x0 = std::floor(r.position.x), y0 = std::floor(r.position.y);
+            const float x1 = std::ceil(r.position.x + r.size.x), y1 = std::ceil(r.position.y + r.size.y);
+            if (!std::isfinite(x0) || !std::isfinite(y0) || !std::isfinite(x1) || !std::isfinite(y1)) continue;
+            out.push_back({ { x0, y0 }, { x1 - x0, y1 - y0 } });
+        }
+        if (out.empty()) return out;
+        maxRects = std::max<std::size_t>(1, maxRects);
+        if (out.size() > kMaxInput) {
+            for (std::size_t i = 1; i < out.size(); ++i) out[0] = unite(out[0], out[i]);
+            out.resize(1);
+            return out;
+        }
+
+        for (;;) {
+            std::size_t bi = 0, bj = 0;
+            bool  touching = false;
+            float best     = std::numeric_limits<float>::max();
+            for (std::size_t i = 0; i < out.size() && !touching; ++i)
+                for (std::size_t j = i + 1; j < out.size(); ++j) {
+                    if (touches(out[i], out[j])) { bi = i; bj = j; touching = true; break; }
+                    const float waste = area(unite(out[i], out[j])) - area(out[i]) - area(out[j]);
+                    if (waste < best) { best = waste; bi = i; bj = j; }
+                }
+            if (!touching && out.size() <= maxRects) break;
+            out[bi] = unite(out[bi], out[bj]);
+            out[bj] = out.back();
+            out.pop_back();
+        }
+        return out;
+    }
+
+    static void clear() {
+        state().drawn.clear();
+        state().removed.clear();
+        utilities::DirtySet::clear();
+    }
+
+private:
+    struct Snapshot {
+        sf::FloatRect world;        // visual bounds, global, clipped
+        sf::FloatRect local;
+        sf::Transform transform;
+        bool operator==(const Snapshot& o) const {
+            return world == o.world && local == o.local && transform == o.transform;
+        }
+    };
+
+    struct State {
+        std::unordered_map<const void*, Snapshot> drawn;
+        std::vector<sf::FloatRect>                removed;
+    };
+
+    static State& state() {
+        static State s;
+        return s;
+    }
+
+    static Snapshot snapshot(ElementRegistry::Id id) {
+        const auto& el = ElementRegistry::at(id).handle;
+        Snapshot snap;
+        snap.local     = el->getVisualBounds();
+        snap.transform = el->getTransform();
+        snap.world     = snap.transform.transformRect(snap.local);
+        const auto clipped = snap.world.findIntersection(ElementRegistry::clipRect(id));
+        snap.world = clipped ? *clipped : sf::FloatRect{};
+        return snap;
+    }
+
+    static sf::FloatRect unite(const sf::FloatRect& a, const sf::FloatRect& b) {
+        const float x0 = std::min(a.position.x, b.position.x), y0 = std::min(a.position.y, b.position.y);
+        const float x1 = std::max(a.position.x + a.size.x, b.position.x + b.size.x);
+        const float y1 = std::max(a.position.y + a.size.y, b.position.y + b.size.y);
+        return { { x0, y0 }, { x1 - x0, y1 - y0 } };
+    }
+
+    static bool touches(const sf::FloatRect& a, const sf::FloatRect& b) {
+        return a.position.x <= b.position.x + b.size.x && b.position.x <= a.position.x + a.size.x
+            && a.position.y <= b.position.y + b.size.y && b.position.y <= a.position.y + a.size.y;
+    }
+
+    static float area(const sf::FloatRect& r) { return r.size.x * r.size.y; }
+};
+
+} // namespace core
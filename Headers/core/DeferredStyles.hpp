@@ -0,0 +1,322 @@
+#pragma once
+#include "../contracts/Types.hpp"
+#include "../utilities/Trace.hpp"
+#include "ContentSize.hpp"
+#include "ElementRegistry.hpp"
+#include "FlexLayout.hpp"
+#include "GridLayout.hpp"
+#include "LayoutCache.hpp"
+#include "RuleParser.hpp"
+#include "StyleEngine.hpp"
+#include "Variables.hpp"
+#include <SFML/Graphics/RenderWindow.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace core {
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  DeferredStyles
+//
+//  Style() calls made while deferring (CSS::deferLayout) only record
+//  intent; flush() turns a frame's worth of them into one pass:
+//
+//    merge     every call for an element is folded into one request: its
+//              rules in call order, one value per property (the last), the
+//              latest parent and the latest children given
+//    style     each element is styled once with its merged rules, without
+//              laying out children, in the order elements were first
+//              styled — a parent before what is sized against it
+//    layout    each container's content size and flex/grid runs once,
+//              nested containers before the ones holding them, after
+//              every child already has its final size
+//
+//  An element styled, given children and styled again — the usual way to
+//  build a card — is dispatched once and laid out once.
+//
+//  The first flush after CSS::useLayoutCache looks its layout step up in
+//  the LayoutCache file: on a hit the stored geometry is copied onto the
+//  elements instead, on a miss the layout runs and its result is stored.
+//  If deferring was only turned on for that flush (deferOnce), it goes
+//  back off once the flush is done.
+// ─────────────────────────────────────────────────────────────────────────────
+
+struct DeferredStyles {
+
+    [[nodiscard]] static bool enabled() { return state().enabled; }
+    static void enable(bool on) {
+        state().enabled = on;
+        state().once    = false;
+    }
+
+    // Defers until the next flush, unless deferring is already on
+    static void deferOnce() {
+        auto& s = state();
+        if (s.enabled) return;
+        s.enabled = true;
+        s.once    = true;
+    }
+
+    static void record(
+        contracts::Styleable                    self,
+        const std::vector<std::string>&         rules,
+        std::optional<contracts::Styleable>     parent,
+        std::optional<contracts::StyleableList> children
+    ) {
+        auto& s = state();
+        const void* native = self->native();
+        auto [it, added] = s.slot.try_emplace(native, s.requests.size());
+        if (added) s.requests.push_back({ std::move(self), {}, std::nullopt, std::nullopt });
+
+        Request& r = s.requests[it->second];
+        r.rules.insert(r.rules.end(), rules.begin(), rules.end());
+        if (parent)   r.parent   = std::move(parent);
+        if (children) r.children = std::move(children);
+    }
+
+    [[nodiscard]] static bool pending() { return !state().requests.empty(); }
+
+    static void flush(sf::RenderWindow& window) {
+        auto& s = state();
+        if (s.requests.empty()) return;
+        CSS_TRACE_ZONE("DeferredStyles::flush");
+
+        std::vector<Request> requests;
+        requests.swap(s.requests);
+        s.slot.clear();
+        const bool useCache = LayoutCache::take();
+        if (s.once) enable(false);
+
+        // Style, leaving layout for below
+        std::vector<Styled>    styled;
+        std::vector<Container> containers;
+        LayoutCache::Hasher    styles;
+        styled.reserve(requests.size());
+        for (Request& r : requests) {
+            if (!r.self.valid()) continue;
+            const sf::Vector2f before = r.self->getSize();
+            const std::vector<std::string> rules = merge(r.rules);
+            contracts::StyleableList* children = r.children ? &*r.children : nullptr;
+            contracts::StyleContext ctx = StyleEngine::styleDeferred(r.self, rules, r.parent, children, window);
+            styled.push_back({ r.self, before });
+            if (children) containers.push_back({ std::move(ctx), std::move(*children) });
+            if (useCache) {
+                for (const auto& rule : rules) styles.add(rule);
+                addResolved(styles, r.self);
+            }
+        }
+
+        // Lay out, inner containers first — or take the result from the cache
+        std::unordered_map<const void*, std::size_t> index;
+        for (std::size_t i = 0; i < containers.size(); ++i) index[containers[i].ctx.self->native()] = i;
+        if (!useCache) {
+            layOut(containers, index);
+        } else {
+            Tree tree = describe(requests, containers, window, styles);
+            std::vector<LayoutCache::Geometry> stored;
+            if (LayoutCache::load(tree.key, stored) && stored.size() == tree.nodes.size()) {
+                restore(tree, stored);
+            } else {
+                layOut(containers, index);
+                LayoutCache::save(tree.key, capture(tree));
+            }
+        }
+
+        // Content-sized containers this flush didn't lay out follow their
+        // resized children
+        for (const Styled& el : styled) {
+            const ElementRegistry::Id id = ElementRegistry::find(el.self->native());
+            if (id == ElementRegistry::kInvalid) continue;
+            const ElementRegistry::Id container = ElementRegistry::at(id).container;
+            if (container != ElementRegistry::kInvalid
+                && index.count(ElementRegistry::at(container).handle->native())) continue;
+            StyleEngine::resized(id, el.before, window);
+        }
+    }
+
+    static void forget(const void* native) {
+        auto& s = state();
+        if (s.requests.empty()) return;
+        const auto it = s.slot.find(native);
+        if (it != s.slot.end()) {
+            s.requests[it->second].self = {};
+            s.slot.erase(it);
+        }
+        for (Request& r : s.requests) {
+            if (r.parent && r.parent->valid() && (*r.parent)->native() == native) r.parent.reset();
+            if (r.children)
+                r.children->erase(std::remove_if(r.children->begin(), r.children->end(),
+                                                 [native](const contracts::Styleable& c) { return c->native() == native; }),
+                                  r.children->end());
+        }
+    }
+
+private:
+    struct Request {
+        contracts::Styleable                    self;
+        std::vector<std::string>                rules;
+        std::optional<contracts::Styleable>     parent;
+        std::optional<contracts::StyleableList> children;
+    };
+
+    struct Styled {
+        contracts::Styleable self;
+        sf::Vector2f         before;        // size before the flush styled it
+    };
+
+    struct Container {
+        contracts::StyleContext  ctx;
+        contracts::StyleableList children;
+    };
+
+    struct State {
+        std::vector<Request>                         requests;    // first-styled order
+        std::unordered_map<const void*, std::size_t> slot;
+        bool                                         enabled = false;
+        bool                                         once    = false;   // deferOnce
+    };
+
+    static State& state() {
+        static State s;
+        return s;
+    }
+
+    // Rules in call order, keeping only the last declaration of each
+    // property; state blocks are kept as they are (later ones replace
+    // earlier ones for the same state when merged into the record)
+    static std::vector<std::string> merge(const std::vector<std::string>& rules) {
+        std::vector<std::string> out;
+        std::vector<std::string> properties;    // parallel to out; empty for state blocks
+        std::unordered_map<std::string, std::size_t> last;
+        out.reserve(rules.size());
+        for (const auto& rule : rules) {
+            const auto decls = RuleParser::parse({ rule });
+            std::string property = decls.size() == 1 ? decls.front().property : std::string{};
+            if (!property.empty()) last[property] = out.size();
+            out.push_back(rule);
+            properties.push_back(std::move(property));
+        }
+        if (last.size() == out.size()) return out;
+
+        std::vector<std::string> kept;
+        kept.reserve(out.size());
+        for (std::size_t i = 0; i < out.size(); ++i)
+            if (properties[i].empty() || last[properties[i]] == i) kept.push_back(std::move(out[i]));
+        return kept;
+    }
+
+    static void layOut(std::vector<Container>& containers,
+                       const std::unordered_map<const void*, std::size_t>& index) {
+        std::vector<bool> done(containers.size(), false);
+        for (std::size_t i = 0; i < containers.size(); ++i) layOut(containers, index, done, i);
+    }
+
+    static void layOut(std::vector<Container>& containers,
+                       const std::unordered_map<const void*, std::size_t>& index,
+                       std::vector<bool>& done, std::size_t i) {
+        if (done[i]) return;
+        done[i] = true;
+        Container& c = containers[i];
+        for (const auto& child : c.children) {
+            const auto it = index.find(child->native());
+            if (it != index.end()) layOut(containers, index, done, it->second);
+        }
+
+        ContentSize::apply(c.ctx, c.children);
+        if (c.ctx.grid.enabled) GridLayout::apply(c.ctx, c.children);
+        else                    FlexLayout::apply(c.ctx, c.children);
+        ElementRegistry::track(c.children);
+        ElementRegistry::track(c.ctx.self);
+    }
+
+    // ── Layout cache ──────────────────────────────────────────────────────
+
+    // Every element the flush styled or laid out, in the order first met,
+    // with the size styling left it at
+    struct Tree {
+        LayoutCache::Key                  key;
+        std::vector<contracts::Styleable> nodes;
+        std::vector<sf::Vector2f>         own;
+    };
+
+    static Tree describe(const std::vector<Request>& requests, const std::vector<Container>& containers,
+                         sf::RenderWindow& window, const LayoutCache::Hasher& styles) {
+        Tree t;
+        std::unordered_map<const void*, std::uint64_t> ordinal;
+        auto node = [&](const contracts::Styleable& el) -> std::uint64_t {
+            auto [it, added] = ordinal.try_emplace(el->native(), t.nodes.size());
+            if (added) {
+                t.nodes.push_back(el);
+                t.own.push_back(el->getSize());
+            }
+            return it->second;
+        };
+
+        LayoutCache::Hasher tree;
+        std::size_t c = 0;
+        for (const Request& r : requests) {
+            if (!r.self.valid()) continue;
+            tree.add(node(r.self));
+            tree.add(r.self->typeName());
+            tree.add(r.parent && r.parent->valid() ? node(*r.parent) + 1 : 0);
+            if (!r.children) continue;
+            const auto& children = containers[c++].children;
+            tree.add(std::uint64_t{ children.size() });
+            for (const auto& child : children) {
+                tree.add(node(child));
+                tree.add(child->typeName());
+            }
+        }
+        for (std::size_t i = 0; i < t.nodes.size(); ++i) {
+            tree.add(t.own[i]);
+            tree.add(t.nodes[i]->getPosition());
+            tree.add(t.nodes[i]->getScale());
+        }
+
+        t.key = { styles.value(), tree.value(), sf::Vector2f(window.getSize()) };
+        return t;
+    }
+
+    // The value every var() declaration of the element resolved to while
+    // it was styled, so a launch with other variable values misses
+    static void addResolved(LayoutCache::Hasher& h, const contracts::Styleable& el) {
+        const ElementRegistry::Id id = ElementRegistry::find(el->native());
+        if (id == ElementRegistry::kInvalid) return;
+        const auto& rec = ElementRegistry::at(id);
+        for (const auto& d : rec.declared) {
+            if (!Variables::hasReference(d.value)) continue;
+            const auto it = rec.varValues.find(d.property);
+            h.add(d.property);
+            h.add(it != rec.varValues.end() ? it->second : std::string());
+        }
+    }
+
+    static std::vector<LayoutCache::Geometry> capture(const Tree& t) {
+        std::vector<LayoutCache::Geometry> out;
+        out.reserve(t.nodes.size());
+        for (const auto& el : t.nodes) out.push_back({ el->getPosition(), el->getSize(), el->getScale() });
+        return out;
+    }
+
+    // Puts every element where the layout would have, and tells FlexLayout
+    // the sizes it would have assigned so a later relayout flexes from the
+    // elements' own sizes
+    static void restore(const Tree& t, const std::vector<LayoutCache::Geometry>& cached) {
+        CSS_TRACE_ZONE("DeferredStyles::restore");
+        for (std::size_t i = 0; i < t.nodes.size(); ++i) {
+            const auto& el = t.nodes[i];
+            const LayoutCache::Geometry& g = cached[i];
+            if (el->getSize()     != g.size)     el->setSize(g.size);
+            if (el->getScale()    != g.scale)    el->setScale(g.scale);
+            if (el->getPosition() != g.position) el->setPosition(g.position);
+            FlexLayout::assume(el->native(), t.own[i], el->getSize());
+            ElementRegistry::track(el);
+        }
+    }
+};
+
+} // namespace core
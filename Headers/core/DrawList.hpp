@@ -0,0 +1,157 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace core {
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  DrawList
+//
+//  Paint order of every registered element, kept sorted incrementally.
+//
+//  Each element's sort key is its path through the stacking contexts that
+//  contain it — one (z-index, order) level per enclosing context, then its
+//  own level:
+//
+//    popup   (z 10)       → [(10, 4)]
+//    button in popup      → [(10, 4), (0, 7)]
+//    tooltip (z 20)       → [(20, 9)]
+//
+//  Keys compare lexicographically with a prefix first, so a context paints
+//  before its contents and its whole subtree stays between its siblings.
+//  `order` (first-styled order) breaks ties, which keeps the sort stable.
+//
+//  The list is a balanced tree of ids, so changing one element's z-index is
+//  one erase plus one insert — O(log n). A context that moves re-inserts
+//  the members it contains; nothing is ever fully re-sorted.
+// ─────────────────────────────────────────────────────────────────────────────
+
+class DrawList {
+public:
+    using Id = std::uint32_t;
+    static constexpr Id kNone = ~Id{0};
+
+    DrawList() : set_(Less{ this }) {}
+    DrawList(const DrawList&)            = delete;
+    DrawList& operator=(const DrawList&) = delete;
+
+    // Places `id` at level (z, order) inside `context` (kNone → root).
+    void update(Id id, Id context, int z, std::uint64_t order) {
+        if (id >= entries_.size()) {
+            entries_.resize(id + 1);
+            where_.resize(id + 1, set_.end());
+        }
+        if (context != kNone && (context >= entries_.size() || !entries_[context].present))
+            context = kNone;
+
+        Entry& e = entries_[id];
+        std::vector<Level> path;
+        if (context != kNone) path = entries_[context].path;
+        path.push_back({ z, order });
+
+        if (e.present && e.context == context && e.path == path) return;
+
+        if (e.present) set_.erase(where_[id]);
+        if (e.present && e.context != context) leave(id, e.context);
+        if ((!e.present || e.context != context) && context != kNone) members_[context].insert(id);
+
+        e.path    = std::move(path);
+        e.context = context;
+        e.z       = z;
+        e.order   = order;
+        e.present = true;
+        where_[id] = set_.insert(id).first;
+
+        // Contents of this element follow it
+        auto it = members_.find(id);
+        if (it == members_.end()) return;
+        const std::vector<Id> inside(it->second.begin(), it->second.end());
+        for (Id m : inside) update(m, id, entries_[m].z, entries_[m].order);
+    }
+
+    void remove(Id id) {
+        if (id >= entries_.size() || !entries_[id].present) return;
+        Entry& e = entries_[id];
+        set_.erase(where_[id]);
+        where_[id] = set_.end();
+        leave(id, e.context);
+        e.present = false;
+
+        // Orphaned contents move up to this element's own context
+        auto it = members_.find(id);
+        if (it == members_.end()) return;
+        const std::vector<Id> inside(it->second.begin(), it->second.end());
+        members_.erase(it);
+        for (Id m : inside) {
+            entries_[m].context = kNone;
+            update(m, e.context, entries_[m].z, entries_[m].order);
+        }
+    }
+
+    void clear() {
+        set_.clear();
+        entries_.clear();
+        where_.clear();
+        members_.clear();
+    }
+
+    // True if `a` is painted before (below) `b`.
+    [[nodiscard]] bool before(Id a, Id b) const { return Less{ this }(a, b); }
+
+    [[nodiscard]] std::size_t size() const { return set_.size(); }
+
+    // Back to front
+    template<typename F>
+    void visit(F&& f) const {
+        for (Id id : set_) f(id);
+    }
+
+private:
+    struct Level {
+        int           z     = 0;
+        std::uint64_t order = 0;
+        bool operator==(const Level& o) const { return z == o.z && order == o.order; }
+    };
+
+    struct Entry {
+        std::vector<Level> path;
+        Id                 context = kNone;
+        int                z       = 0;
+        std::uint64_t      order   = 0;
+        bool               present = false;
+    };
+
+    struct Less {
+        const DrawList* self;
+        bool operator()(Id a, Id b) const {
+            const auto& pa = self->entries_[a].path;
+            const auto& pb = self->entries_[b].path;
+            const std::size_t n = std::min(pa.size(), pb.size());
+            for (std::size_t i = 0; i < n; ++i) {
+                if (pa[i].z     != pb[i].z)     return pa[i].z     < pb[i].z;
+                if (pa[i].order != pb[i].order) return pa[i].order < pb[i].order;
+            }
+            if (pa.size() != pb.size()) return pa.size() < pb.size();
+            return a < b;
+        }
+    };
+
+    void leave(Id id, Id context) {
+        if (context == kNone) return;
+        auto it = members_.find(context);
+        if (it == members_.end()) return;
+        it->second.erase(id);
+        if (it->second.empty()) members_.erase(it);
+    }
+
+    std::vector<Entry>                               entries_;
+    std::set<Id, Less>                               set_;
+    std::vector<std::set<Id, Less>::iterator>        where_;
+    std::unordered_map<Id, std::unordered_set<Id>>   members_;   // context → direct contents
+};
+
+} // namespace core
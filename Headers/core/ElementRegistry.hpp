@@ -0,0 +1,391 @@
+#pragma once
+#include "../contracts/Types.hpp"
+#include "Culling.hpp"
+#include "DrawList.hpp"
+#include "SpatialIndex.hpp"
+#include "StateStyles.hpp"
+#include "Variables.hpp"
+#include "../utilities/DirtySet.hpp"
+#include "../utilities/Trace.hpp"
+#include <algorithm>
+#include <limits>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace core {
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  ElementRegistry
+//
+//  Remembers every element that went through CSS::Style() (as the styled
+//  element or as a child) together with its final global bounds, and keeps
+//  those bounds in a SpatialIndex for picking.
+//
+//  Each record also keeps what is needed to style the element again without
+//  the caller: its declarations merged across Style() calls, the parent and
+//  children of the last call, and its compiled pseudo-class states.
+//
+//  Identity is the address of the wrapped SFML object (IStyleable::native()),
+//  so re-wrapping the same sf::RectangleShape maps to the same record.
+//  Elements must be forgotten before their SFML object is destroyed.
+//
+//  Paint order comes from the DrawList: z-index within stacking contexts,
+//  then the order in which elements were first styled. An element with a
+//  z-index is a stacking context for everything styled with it as parent
+//  (or laid out by it as container). drawAll() and picking both use it.
+//
+//  overflow: hidden clips descendants to the element's global box (nested
+//  clips intersect). Visual bounds (shadow included) are mirrored in
+//  BoxArrays so visibility for a whole frame is one Culling pass over
+//  contiguous arrays.
+//
+//  Picking honours rotation and scale:
+//    hitTest — point is mapped into each candidate's local space
+//    query   — separating-axis test between the query rect and the
+//              element's oriented box (world axes via the grid, local axes
+//              via the inverse transform)
+// ─────────────────────────────────────────────────────────────────────────────
+
+struct ElementRegistry {
+
+    using Id = std::uint32_t;
+    static constexpr Id kInvalid = ~Id{0};
+
+    struct Record {
+        contracts::Styleable handle;
+        const void*          native = nullptr;
+        sf::FloatRect        bounds;           // global AABB
+        std::uint64_t        order  = 0;
+
+        // Style inputs
+        std::vector<contracts::Declaration> declared;      // merged, latest wins
+        contracts::Styleable                parent;        // invalid → window
+        contracts::StyleableList            children;
+        bool                                hasChildren = false;
+        Id                                  container   = kInvalid; // lays this element out
+        bool                                contentSized = false;   // width/height from its children
+
+        StateStyles::Set                    states;
+        std::optional<int>                  zIndex;        // nullopt → auto
+        bool                                clips     = false;     // overflow: hidden
+
+        // Custom properties
+        std::unordered_map<std::string, std::string> vars;       // scoped "--name" definitions
+        std::vector<std::string>                     varRefs;    // names referenced via var()
+        std::unordered_map<std::string, std::string> varValues;  // property → last resolved value
+    };
+
+    // Valid until the next track() of a new element.
+    [[nodiscard]] static Record& at(Id id) { return storage().records[id]; }
+
+    // Merges a Style() call's declarations into the record. A re-declared
+    // property moves to the end so it still wins over earlier shorthands.
+    static void declare(Record& r, const std::vector<contracts::Declaration>& decls) {
+        for (const auto& d : decls) {
+            auto it = std::find_if(r.declared.begin(), r.declared.end(),
+                [&](const contracts::Declaration& e) { return e.property == d.property; });
+            if (it != r.declared.end()) r.declared.erase(it);
+            r.declared.push_back(d);
+        }
+    }
+
+    // Registers the element (if new) and refreshes its indexed bounds.
+    static Id track(const contracts::Styleable& el) {
+        if (!el.valid()) return kInvalid;
+        auto& s = storage();
+
+        const void* key = el->native();
+        auto it = s.ids.find(key);
+        Id id;
+        if (it != s.ids.end()) {
+            id = it->second;
+        } else {
+            id = allocate();
+            Record& r = s.records[id];
+            r.handle  = el;
+            r.native  = key;
+            r.order   = s.nextOrder++;
+            s.ids.emplace(key, id);
+            s.draw.update(id, DrawList::kNone, 0, r.order);
+            utilities::DirtySet::mark(key, utilities::DirtySet::Paint);     // first drawn next frame
+        }
+
+        Record& r = s.records[id];
+        r.bounds  = el->getGlobalBounds();
+        s.index.update(id, r.bounds);
+        s.boxes.set(id, el->getTransform().transformRect(el->getVisualBounds()));   // culled with its shadow
+        return id;
+    }
+
+    static void track(const contracts::StyleableList& list) {
+        for (const auto& el : list) track(el);
+    }
+
+    static void forget(const void* native) {
+        auto& s = storage();
+        auto it = s.ids.find(native);
+        if (it == s.ids.end()) return;
+
+        const Id id = it->second;
+        Record&  r  = s.records[id];
+
+        // Unlink from the container's child list and orphan our children
+        if (r.container != kInvalid) {
+            auto& siblings = s.records[r.container].children;
+            siblings.erase(std::remove_if(siblings.begin(), siblings.end(),
+                [native](const contracts::Styleable& c) { return c->native() == native; }),
+                siblings.end());
+        }
+        for (const auto& child : r.children) {
+            auto cit = s.ids.find(child->native());
+            if (cit != s.ids.end() && s.records[cit->second].container == id)
+                s.records[cit->second].container = kInvalid;
+        }
+
+        Variables::unlink(id, r.varRefs);
+        s.index.remove(id);
+        s.draw.remove(id);
+        s.boxes.setEmpty(id);
+        if (id < s.clipOwners.size()) s.clipOwners[id] = kInvalid;
+        s.records[id] = Record{};
+        s.free.push_back(id);
+        s.ids.erase(it);
+    }
+
+    static void clear() {
+        auto& s = storage();
+        s.records.clear();
+        s.free.clear();
+        s.ids.clear();
+        s.index.clear();
+        s.draw.clear();
+        s.boxes.clear();
+        s.clipBoxes.clear();
+        s.clipOwners.clear();
+        s.nextOrder = 0;
+        Variables::clearLinks();
+    }
+
+    [[nodiscard]] static Id find(const void* native) {
+        auto it = storage().ids.find(native);
+        return it != storage().ids.end() ? it->second : kInvalid;
+    }
+
+    [[nodiscard]] static std::size_t size() { return storage().ids.size(); }
+
+    // Next element up the style tree: the parent of the last Style() call,
+    // else the container that lays the element out.
+    [[nodiscard]] static Id ancestor(Id id) {
+        const Record& r = storage().records[id];
+        return r.parent.valid() ? find(r.parent->native()) : r.container;
+    }
+
+    // ── Stacking ──────────────────────────────────────────────────────────
+
+    // Re-files the element under its nearest ancestor with a z-index and
+    // records its nearest clipping ancestor. O(log n) unless the element is
+    // itself a context with contents.
+    static void stack(Id id) {
+        auto& s = storage();
+        Id context = DrawList::kNone;
+        Id clip    = kInvalid;
+        Id up = ancestor(id);
+        for (int hop = 0; up != kInvalid && hop < 64; ++hop, up = ancestor(up)) {
+            if (up == id) break;
+            const Record& a = s.records[up];
+            if (context == DrawList::kNone && a.zIndex) context = up;
+            if (clip == kInvalid && a.clips)            clip    = up;
+            if (context != DrawList::kNone && clip != kInvalid) break;
+        }
+        if (id >= s.clipOwners.size()) s.clipOwners.resize(id + 1, kInvalid);
+        s.clipOwners[id] = clip;
+        const Record& r = s.records[id];
+        s.draw.update(id, context, r.zIndex.value_or(0), r.order);
+    }
+
+    // Re-files every element — needed when an element gains or loses its
+    // z-index or overflow clip, since that changes what its descendants
+    // belong to.
+    static void restack() {
+        for (const auto& kv : storage().ids) stack(kv.second);
+    }
+
+    // Back to front
+    template<typename F>
+    static void visitPaintOrder(F&& f) {
+        auto& s = storage();
+        s.draw.visit([&](Id id) { f(s.records[id].handle); });
+    }
+
+    // Back to front, skipping elements outside `area` or their clip rect.
+    // f(handle, clip) — clip is null unless the element is partially clipped.
+    template<typename F>
+    static void visitVisible(const sf::FloatRect& area, F&& f) {
+        CSS_TRACE_ZONE("ElementRegistry::visitVisible");
+        auto& s = storage();
+        refreshClips();
+        Culling::pass(s.boxes, s.clipBoxes, area, s.visible, s.partial);
+
+        auto emit = [&](Id id) {
+            if (!s.partial[id]) { f(s.records[id].handle, static_cast<const sf::FloatRect*>(nullptr)); return; }
+            const sf::FloatRect clip = s.clipBoxes.rect(id);
+            f(s.records[id].handle, &clip);
+        };
+
+        // Few visible: sort just those. Many: walking the list is cheaper.
+        s.shown.clear();
+        for (std::size_t i = 0; i < s.visible.size(); ++i)
+            if (s.visible[i]) s.shown.push_back(static_cast<Id>(i));
+
+        if (s.shown.size() * 8 < s.draw.size()) {
+            std::sort(s.shown.begin(), s.shown.end(), [&](Id a, Id b) { return s.draw.before(a, b); });
+            for (Id id : s.shown) emit(id);
+        } else {
+            s.draw.visit([&](Id id) { if (s.visible[id]) emit(id); });
+        }
+    }
+
+    // Effective clip rect of an element; unbounded if nothing clips it.
+    [[nodiscard]] static sf::FloatRect clipRect(Id id) {
+        constexpr float big = std::numeric_limits<float>::max();
+        sf::FloatRect clip{ { -big / 2.f, -big / 2.f }, { big, big } };
+        auto& s = storage();
+        for (Id c = clipOwner(id), hop = 0; c != kInvalid && hop < 64; c = clipOwner(c), ++hop)
+            clip = intersect(clip, s.records[c].bounds);
+        return clip;
+    }
+
+    // Topmost element under p, or an invalid handle.
+    static contracts::Styleable hitTest(sf::Vector2f p) {
+        auto& s = storage();
+        Id best = kInvalid;
+
+        s.index.visitPoint(p, [&](Id id) {
+            if (best != kInvalid && s.draw.before(id, best)) return;
+            const Record& r = s.records[id];
+            if (clipOwner(id) != kInvalid && !SpatialIndex::contains(clipRect(id), p)) return;
+            const sf::Vector2f local = r.handle->getTransform().getInverse().transformPoint(p);
+            if (SpatialIndex::contains(r.handle->getBounds(), local)) best = id;
+        });
+
+        return best != kInvalid ? s.records[best].handle : contracts::Styleable{};
+    }
+
+    // Every element overlapping `area`, back-to-front.
+    static contracts::StyleableList query(const sf::FloatRect& area) {
+        auto& s = storage();
+        std::vector<Id> hits;
+
+        s.index.visitRect(area, [&](Id id) {
+            if (overlapsOriented(s.records[id], area)) hits.push_back(id);
+        });
+
+        std::sort(hits.begin(), hits.end(),
+                  [&](Id a, Id b) { return s.draw.before(a, b); });
+
+        contracts::StyleableList out;
+        out.reserve(hits.size());
+        for (Id id : hits) out.push_back(s.records[id].handle);
+        return out;
+    }
+
+private:
+    struct Storage {
+        std::vector<Record>                     records;
+        std::vector<Id>                         free;
+        std::unordered_map<const void*, Id>     ids;
+        SpatialIndex                            index;
+        DrawList                                draw;
+        BoxArrays                               boxes;       // global AABB per id
+        BoxArrays                               clipBoxes;   // effective clip per id
+        std::vector<std::uint8_t>               visible, partial;
+        std::vector<Id>                         shown;       // visible ids of the last pass
+        std::vector<Id>                         clipOwners;  // nearest clipping ancestor per id
+        std::vector<sf::FloatRect>              ownerClip;   // resolved clip of each clip owner
+        std::vector<std::uint32_t>              clipStamp;   // memo for ownerClip
+        std::uint32_t                           stamp = 0;
+        std::uint64_t                           nextOrder = 0;
+    };
+
+    static Storage& storage() {
+        static Storage s;
+        return s;
+    }
+
+    static Id allocate() {
+        auto& s = storage();
+        if (!s.free.empty()) {
+            Id id = s.free.back();
+            s.free.pop_back();
+            return id;
+        }
+        s.records.emplace_back();
+        return static_cast<Id>(s.records.size() - 1);
+    }
+
+    static Id clipOwner(Id id) {
+        const auto& owners = storage().clipOwners;
+        return id < owners.size() ? owners[id] : kInvalid;
+    }
+
+    static sf::FloatRect intersect(const sf::FloatRect& a, const sf::FloatRect& b) {
+        const float x0 = std::max(a.position.x, b.position.x);
+        const float y0 = std::max(a.position.y, b.position.y);
+        const float x1 = std::min(a.position.x + a.size.x, b.position.x + b.size.x);
+        const float y1 = std::min(a.position.y + a.size.y, b.position.y + b.size.y);
+        return { { x0, y0 }, { std::max(0.f, x1 - x0), std::max(0.f, y1 - y0) } };
+    }
+
+    // Fills clipBoxes from each element's clip owner. Each owner's clip is
+    // resolved once per pass (memoised by stamp) and shared by its contents.
+    static void refreshClips() {
+        auto& s = storage();
+        const std::size_t n = s.records.size();
+        s.boxes.resize(n);
+        s.clipBoxes.resize(n);
+        s.clipOwners.resize(n, kInvalid);
+        s.ownerClip.resize(n);
+        s.clipStamp.resize(n, 0);
+        if (++s.stamp == 0) {
+            std::fill(s.clipStamp.begin(), s.clipStamp.end(), 0);
+            s.stamp = 1;
+        }
+
+        std::vector<Id> chain;
+        for (std::size_t i = 0; i < n; ++i) {
+            const Id owner = s.clipOwners[i];
+            if (owner == kInvalid) {
+                s.clipBoxes.setUnbounded(i);
+                continue;
+            }
+            if (s.clipStamp[owner] != s.stamp) {
+                // Resolve the owner chain outermost-first
+                chain.clear();
+                for (Id c = owner; c != kInvalid && s.clipStamp[c] != s.stamp && chain.size() < 64;
+                     c = s.clipOwners[c])
+                    chain.push_back(c);
+                for (auto it = chain.rbegin(); it != chain.rend(); ++it) {
+                    const Id outer = s.clipOwners[*it];
+                    s.ownerClip[*it] = (outer != kInvalid && s.clipStamp[outer] == s.stamp)
+                                     ? intersect(s.records[*it].bounds, s.ownerClip[outer])
+                                     : s.records[*it].bounds;
+                    s.clipStamp[*it] = s.stamp;
+                }
+            }
+            s.clipBoxes.set(i, s.ownerClip[owner]);
+        }
+    }
+
+    // Axis-aligned overlap was established by the grid; check the
+    // element's own axes by taking the area into local space.
+    static bool overlapsOriented(const Record& r, const sf::FloatRect& area) {
+        const sf::Transform inv = r.handle->getTransform().getInverse();
+        const sf::FloatRect localArea = inv.transformRect(area);
+        return SpatialIndex::overlaps(localArea, r.handle->getBounds());
+    }
+};
+
+} // namespace core
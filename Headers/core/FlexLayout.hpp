@@ -1,7 +1,13 @@
 #pragma once
 #include "../contracts/Types.hpp"
+#include "../utilities/Trace.hpp"
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <unordered_map>
+#include <vector>
 
 namespace core {
 
@@ -12,15 +18,45 @@ namespace core {
 //
 //  Supported features:
 //    flex-direction   row | column
+//    flex-wrap        nowrap | wrap (wrap-reverse behaves as wrap)
+//    flex-grow / flex-shrink / flex-basis, and the flex / flex-flow shorthands
 //    justify-content  flex-start | flex-end | center |
 //                     space-between | space-around | space-evenly
 //    align-items      flex-start | flex-end | center | stretch
-//    gap              uniform spacing between items
+//    gap              uniform spacing between items and between lines
 //    padding          inner offset from container edges
 //
+//  Pipeline, over flat per-item arrays of main sizes:
+//    1. basis   — flex-basis, or the item's own size when auto, clamped
+//                 by min-/max-width (or -height) into its hypothetical size
+//    2. lines   — items are collected greedily into lines (one line unless
+//                 wrapping)
+//    3. resolve — per line, the CSS freeze loop: free space is shared by
+//                 flex-grow (or flex-shrink × basis), items violating
+//                 their min/max are clamped and frozen, and the rest are
+//                 redistributed until nothing is violated
+//    4. place   — justify-content per line, align-items inside the line;
+//                 lines stack along the cross axis and share any leftover
+//                 cross space (align-content: stretch, the default)
+//
+//  Steps 2 and 3 are cached per container: lines are broken again only
+//  when the inner main size, the gap or an item's basis changes, and
+//  re-resolved only when that happened or a flex factor changed.
+//
+//  An item's own size is remembered across layouts, so an item grown or
+//  shrunk by a previous pass flexes from its declared size, not from the
+//  one this layout gave it. Without flex, children are offset by the
+//  container's origin and padding from their own position, remembered the
+//  same way, so laying the container out again doesn't move them further.
+//
+//  Intent, remembered sizes and caches are per thread: AsyncLayout lays
+//  containers out on its worker from copies it adopt()s there.
+//
 //  Limitations vs. CSS spec (intentional, SFML has no reflow):
-//    • No flex-wrap (single-axis only)
-//    • No flex-grow / flex-shrink / flex-basis on individual children
+//    • min-width / min-height: auto is 0 — SFML elements have no content size
+//    • children declaring none of the flex-* properties are flex: none
+//      (they keep their size, as before flex factors existed)
+//    • no *-reverse directions, no align-content / align-self / order
 //    • No nested flex contexts (children are positioned, not reflowed)
 //
 //  Usage:
@@ -31,10 +67,84 @@ namespace core {
 
 struct FlexLayout {
 
+    struct Natural {
+        sf::Vector2f size;          // the item's own size
+        sf::Vector2f assigned;      // what the last layout set it to
+    };
+
+    struct Offset {
+        sf::Vector2f own;           // the child's position before the offset
+        sf::Vector2f placed;        // where the last offset put it
+    };
+
+    // ── Item intent (written while styling the item) ──────────────────────
+    static contracts::FlexItem& item(const void* native) {
+        return items()[native];
+    }
+
+    static contracts::SizeLimits& limits(const void* native) {
+        return sizeLimits()[native];
+    }
+
+    [[nodiscard]] static const contracts::SizeLimits* findLimits(const void* native) {
+        const auto it = sizeLimits().find(native);
+        return it != sizeLimits().end() ? &it->second : nullptr;
+    }
+
+    [[nodiscard]] static const contracts::FlexItem* findItem(const void* native) {
+        const auto it = items().find(native);
+        return it != items().end() ? &it->second : nullptr;
+    }
+
+    [[nodiscard]] static const Natural* findNatural(const void* native) {
+        const auto it = naturals().find(native);
+        return it != naturals().end() ? &it->second : nullptr;
+    }
+
+    [[nodiscard]] static const Offset* findOffset(const void* native) {
+        const auto it = offsets().find(native);
+        return it != offsets().end() ? &it->second : nullptr;
+    }
+
+    // Replaces this thread's intent and remembered size for the element
+    // with copies taken on another thread (AsyncLayout); nullopt drops them
+    static void adopt(const void* native, const std::optional<contracts::FlexItem>& flex,
+                      const std::optional<contracts::SizeLimits>& lim,
+                      const std::optional<Natural>& natural, const std::optional<Offset>& offset) {
+        if (flex)    items()[native] = *flex;
+        else         items().erase(native);
+        if (lim)     sizeLimits()[native] = *lim;
+        else         sizeLimits().erase(native);
+        if (natural) naturals()[native] = *natural;
+        else         naturals().erase(native);
+        adopt(native, offset);
+    }
+
+    // Where another thread's padding offset put the child (AsyncLayout)
+    static void adopt(const void* native, const std::optional<Offset>& offset) {
+        if (offset) offsets()[native] = *offset;
+        else        offsets().erase(native);
+    }
+
+    // An item given `assigned` without a layout running (LayoutCache):
+    // remembered as if a layout had grown or shrunk it from `own`
+    static void assume(const void* native, sf::Vector2f own, sf::Vector2f assigned) {
+        remember(native, naturalSize(native, own), assigned);
+    }
+
+    static void forget(const void* native) {
+        items().erase(native);
+        sizeLimits().erase(native);
+        naturals().erase(native);
+        offsets().erase(native);
+        caches().erase(native);
+    }
+
     static void apply(
         const contracts::StyleContext& ctx,
         contracts::StyleableList&      children
     ) {
+        CSS_TRACE_ZONE("FlexLayout::apply");
         if (children.empty()) return;
 
         if (ctx.flex.enabled)
@@ -43,55 +153,264 @@ struct FlexLayout {
             applyPaddingOffset(ctx, children);
     }
 
+    // Content box the items need when rows may be `availWidth` wide: each
+    // item at its hypothetical size, lines broken as apply() would break
+    // them (an infinite width keeps one line, 0 puts every item on its own).
+    // Columns are measured at an indefinite height.
+    static sf::Vector2f measure(
+        const contracts::StyleContext& ctx,
+        const contracts::StyleableList& children,
+        float                           availWidth
+    ) {
+        CSS_TRACE_ZONE("FlexLayout::measure");
+        if (children.empty()) return { 0.f, 0.f };
+
+        const bool isColumn = ctx.flex.column;
+        Scratch& s = scratch();
+        gather(children, isColumn, -1.f, s);
+        s.cross.resize(children.size());
+        for (std::size_t i = 0; i < children.size(); ++i)
+            s.cross[i] = isColumn ? s.natural[i].x : s.natural[i].y;
+
+        const float avail = isColumn ? std::numeric_limits<float>::infinity() : availWidth;
+        Measure& m = caches()[ctx.self->native()].measured;
+        if (!(avail == m.avail && ctx.flex.gap == m.gap && ctx.flex.wrap == m.wrap
+              && isColumn == m.column && s.hypo == m.hypo && s.cross == m.cross)) {
+            m.avail = avail; m.gap = ctx.flex.gap; m.wrap = ctx.flex.wrap; m.column = isColumn;
+            m.hypo = s.hypo; m.cross = s.cross;
+
+            breakLines(m.hypo, m.avail, m.gap, m.wrap, s.lines);
+            float mainSize = 0.f, crossSize = 0.f;
+            for (std::size_t l = 0; l + 1 < s.lines.size(); ++l) {
+                float used = 0.f, tallest = 0.f;
+                for (std::size_t i = s.lines[l]; i < s.lines[l + 1]; ++i) {
+                    used   += m.hypo[i] + (i > s.lines[l] ? m.gap : 0.f);
+                    tallest = std::max(tallest, m.cross[i]);
+                }
+                mainSize   = std::max(mainSize, used);
+                crossSize += tallest + (l > 0 ? m.gap : 0.f);
+            }
+            m.size = isColumn ? sf::Vector2f{ crossSize, mainSize } : sf::Vector2f{ mainSize, crossSize };
+        }
+        return m.size;
+    }
+
 private:
+    // Per-call working arrays, reused across calls to avoid reallocating
+    struct Scratch {
+        std::vector<sf::Vector2f> natural;              // item's own size
+        std::vector<float>        base, hypo, min, max; // main axis
+        std::vector<float>        grow, shrink;
+        std::vector<float>        violation;
+        std::vector<std::uint8_t> frozen;
+        std::vector<float>        lineCross;
+        std::vector<float>        cross;                // measure(): item cross sizes
+        std::vector<std::size_t>  lines;                // measure(): line starts
+    };
+
+    // Inputs and result of the last measure()
+    struct Measure {
+        float              avail  = -1.f;
+        float              gap    = -1.f;
+        bool               wrap   = false;
+        bool               column = false;
+        std::vector<float> hypo, cross;
+        sf::Vector2f       size;
+    };
+
+    struct Cache {
+        // Inputs of the last run
+        float              avail = -1.f;
+        float              gap   = -1.f;
+        bool               wrap  = false;
+        std::vector<float> hypo, base, min, max, grow, shrink;
+
+        // Outputs
+        std::vector<std::size_t> lines;     // first item of each line, then n
+        std::vector<float>       target;    // resolved main size per item
+
+        Measure measured;
+
+        void resolve(Scratch& s, float a, float g, bool w) {
+            const bool rebreak = !(a == avail && g == gap && w == wrap && s.hypo == hypo);
+            if (rebreak) {
+                avail = a; gap = g; wrap = w; hypo = s.hypo;
+                FlexLayout::breakLines(hypo, avail, gap, wrap, lines);
+            }
+            if (!rebreak && s.base == base && s.min == min && s.max == max
+                         && s.grow == grow && s.shrink == shrink) return;
+            base = s.base; min = s.min; max = s.max; grow = s.grow; shrink = s.shrink;
+
+            target.resize(hypo.size());
+            for (std::size_t l = 0; l + 1 < lines.size(); ++l)
+                FlexLayout::resolveLine(s, lines[l], lines[l + 1], avail, gap, target);
+        }
+    };
+
+
+    static std::unordered_map<const void*, contracts::FlexItem>& items() {
+        thread_local std::unordered_map<const void*, contracts::FlexItem> m;
+        return m;
+    }
+
+    static std::unordered_map<const void*, contracts::SizeLimits>& sizeLimits() {
+        thread_local std::unordered_map<const void*, contracts::SizeLimits> m;
+        return m;
+    }
+
+    static std::unordered_map<const void*, Natural>& naturals() {
+        thread_local std::unordered_map<const void*, Natural> m;
+        return m;
+    }
+
+    static std::unordered_map<const void*, Offset>& offsets() {
+        thread_local std::unordered_map<const void*, Offset> m;
+        return m;
+    }
+
+    static std::unordered_map<const void*, Cache>& caches() {
+        thread_local std::unordered_map<const void*, Cache> c;
+        return c;
+    }
+
+    static Scratch& scratch() {
+        thread_local Scratch s;
+        return s;
+    }
+
     // ── Flex distribution ─────────────────────────────────────────────────
 
     static void applyFlex(const contracts::StyleContext& ctx, contracts::StyleableList& children)
     {
-        sf::Vector2f containerPos  = ctx.self->getPosition();
-        sf::Vector2f containerSize = ctx.self->getSize();
+        const sf::Vector2f origin = ctx.self->getPosition() + ctx.box.paddingOffset();
+        const sf::Vector2f inner  = ctx.box.innerSize(ctx.self->getSize());
 
-        // Inner area after padding
-        float innerX = containerPos.x + ctx.box.paddingLeft;
-        float innerY = containerPos.y + ctx.box.paddingTop;
-        float innerW = containerSize.x - ctx.box.paddingLeft - ctx.box.paddingRight;
-        float innerH = containerSize.y - ctx.box.paddingTop  - ctx.box.paddingBottom;
+        const bool  isColumn   = ctx.flex.column;
+        const float gap        = ctx.flex.gap;
+        const float mainAvail  = isColumn ? inner.y : inner.x;
+        const float crossAvail = isColumn ? inner.x : inner.y;
+        auto main  = [isColumn](sf::Vector2f v) { return isColumn ? v.y : v.x; };
+        auto cross = [isColumn](sf::Vector2f v) { return isColumn ? v.x : v.y; };
 
-        const bool isColumn = ctx.flex.column;
-        const float gap     = ctx.flex.gap;
+        // 1. Flat per-item inputs
+        Scratch& s = scratch();
+        gather(children, isColumn, mainAvail, s);
 
-        // Main-axis: total children size
-        float totalMain = 0.f;
-        for (auto& child : children) {
-            auto sz = child->getSize();
-            totalMain += isColumn ? sz.y : sz.x;
+        // 2-3. Lines and resolved main sizes
+        Cache& cache = caches()[ctx.self->native()];
+        cache.resolve(s, mainAvail, gap, ctx.flex.wrap);
+        const auto& lines = cache.lines;
+        const std::size_t lineCount = lines.size() - 1;
+
+        // Line cross sizes: the container's for a single line, else the
+        // largest item, plus an equal share of the leftover cross space
+        std::vector<float>& lineCross = s.lineCross;
+        lineCross.assign(lineCount, crossAvail);
+        if (ctx.flex.wrap) {
+            float used = gap * static_cast<float>(lineCount - 1);
+            for (std::size_t l = 0; l < lineCount; ++l) {
+                float c = 0.f;
+                for (std::size_t i = lines[l]; i < lines[l + 1]; ++i) c = std::max(c, cross(s.natural[i]));
+                lineCross[l] = c;
+                used += c;
+            }
+            const float extra = crossAvail - used;
+            if (extra > 0.f)
+                for (float& c : lineCross) c += extra / static_cast<float>(lineCount);
         }
 
-        float mainAvail  = isColumn ? innerH : innerW;
-        float gapTotal   = gap * static_cast<float>(std::max(0, static_cast<int>(children.size()) - 1));
-        float remaining  = mainAvail - totalMain - gapTotal;
+        // 4. Place, line by line
+        using A = contracts::FlexLayout::Align;
+        float crossCursor = cross(origin);
+        for (std::size_t l = 0; l < lineCount; ++l) {
+            const std::size_t first = lines[l], last = lines[l + 1];
+            const std::size_t count = last - first;
 
-        // justify-content → starting offset and per-item extra spacing
-        float offset  = 0.f;
-        float between = 0.f;
-        using J = contracts::FlexLayout::Justify;
-        const size_t n = children.size();
+            float used = gap * static_cast<float>(count - 1);
+            for (std::size_t i = first; i < last; ++i) used += cache.target[i];
+
+            float offset = 0.f, between = 0.f;
+            justify(ctx.flex.justify, mainAvail - used, count, offset, between);
+
+            float cursor = main(origin) + offset;
+            for (std::size_t i = first; i < last; ++i) {
+                auto& child = children[i];
+                const float crossEl = ctx.flex.align == A::Stretch ? lineCross[l] : cross(s.natural[i]);
+                const sf::Vector2f want = isColumn ? sf::Vector2f{ crossEl, cache.target[i] }
+                                                   : sf::Vector2f{ cache.target[i], crossEl };
+                if (child->getSize() != want) child->setSize(want);
+                const sf::Vector2f sz = child->getSize();
+                remember(child->native(), s.natural[i], sz);
+
+                float crossPos = crossCursor;
+                switch (ctx.flex.align) {
+                    case A::End:    crossPos += lineCross[l] - cross(sz);        break;
+                    case A::Center: crossPos += (lineCross[l] - cross(sz)) / 2.f; break;
+                    default:                                                      break;
+                }
+
+                const sf::Vector2f target = isColumn ? sf::Vector2f{ crossPos, cursor }
+                                                     : sf::Vector2f{ cursor, crossPos };
+                if (child->getPosition() != target) child->setPosition(target);
+
+                // Advance cursor: main size + gap + justify extra spacing
+                cursor += main(sz) + gap + between;
+            }
+            crossCursor += lineCross[l] + gap;
+        }
+    }
+
+    // Own sizes, limits, flex factors and hypothetical main sizes; a
+    // negative mainAvail (indefinite) makes % bases auto
+    static void gather(const contracts::StyleableList& children, bool isColumn, float mainAvail,
+                       Scratch& s) {
+        auto main = [isColumn](sf::Vector2f v) { return isColumn ? v.y : v.x; };
+        const std::size_t n = children.size();
+        s.natural.resize(n);
+        s.base.resize(n); s.hypo.resize(n); s.min.resize(n); s.max.resize(n);
+        s.grow.resize(n); s.shrink.resize(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            const void* native = children[i]->native();
+            s.natural[i] = naturalSize(native, children[i]->getSize());
+
+            const contracts::SizeLimits* lim = findLimits(native);
+            s.min[i] = lim ? main(lim->min) : 0.f;
+            s.max[i] = lim ? main(lim->max) : std::numeric_limits<float>::infinity();
+
+            const auto it = items().find(native);
+            if (it == items().end()) {
+                // flex: none — fixed at the item's own size
+                s.base[i] = main(s.natural[i]);
+                s.grow[i] = s.shrink[i] = 0.f;
+            } else {
+                const contracts::FlexItem& f = it->second;
+                s.base[i]   = !f.basis          ? main(s.natural[i])
+                            : !f.basisPercent   ? *f.basis
+                            : mainAvail >= 0.f  ? mainAvail * *f.basis / 100.f
+                            :                     main(s.natural[i]);
+                s.grow[i]   = f.grow;
+                s.shrink[i] = f.shrink;
+            }
+            s.hypo[i] = std::max(s.min[i], std::min(s.base[i], s.max[i]));
+        }
+    }
 
-        switch (ctx.flex.justify) {
+    // justify-content → starting offset and per-item extra spacing
+    static void justify(contracts::FlexLayout::Justify j, float remaining, std::size_t n,
+                        float& offset, float& between) {
+        using J = contracts::FlexLayout::Justify;
+        offset  = 0.f;
+        between = 0.f;
+        switch (j) {
             case J::Start:
-                offset  = 0.f;
-                between = 0.f;
                 break;
             case J::End:
                 offset  = remaining;
-                between = 0.f;
                 break;
             case J::Center:
                 offset  = remaining / 2.f;
-                between = 0.f;
                 break;
             case J::SpaceBetween:
-                offset  = 0.f;
                 between = n > 1 ? remaining / static_cast<float>(n - 1) : 0.f;
                 break;
             case J::SpaceAround:
@@ -103,55 +422,105 @@ private:
                 offset  = between;
                 break;
         }
+    }
 
-        // Iterate children and position each one
-        float cursor = (isColumn ? innerY : innerX) + offset;
+    // ── Lines ─────────────────────────────────────────────────────────────
+    // Greedy: an item starts a new line when it would overflow the current
+    // one (a line always holds at least one item)
+    static void breakLines(const std::vector<float>& hypo, float avail, float gap, bool wrap,
+                           std::vector<std::size_t>& lines) {
+        lines.assign(1, 0);
+        float used = 0.f;
+        for (std::size_t i = 0; i < hypo.size(); ++i) {
+            if (i == lines.back()) { used = hypo[i]; continue; }
+            if (wrap && used + gap + hypo[i] > avail) {
+                lines.push_back(i);
+                used = hypo[i];
+            } else {
+                used += gap + hypo[i];
+            }
+        }
+        lines.push_back(hypo.size());
+    }
 
-        for (auto& child : children) {
-            sf::Vector2f sz = child->getSize();
-
-            // Cross-axis alignment
-            using A = contracts::FlexLayout::Align;
-            float crossAvail = isColumn ? innerW : innerH;
-            float crossStart = isColumn ? innerX : innerY;
-            float crossEl    = isColumn ? sz.x   : sz.y;
-            float crossPos;
-
-            switch (ctx.flex.align) {
-                case A::Start:
-                    crossPos = crossStart;
-                    break;
-                case A::End:
-                    crossPos = crossStart + crossAvail - crossEl;
-                    break;
-                case A::Center:
-                    crossPos = crossStart + (crossAvail - crossEl) / 2.f;
-                    break;
-                case A::Stretch:
-                    crossPos = crossStart;
-                    if (isColumn) child->setSize({ innerW, sz.y });
-                    else          child->setSize({ sz.x, innerH });
-                    // Refresh sz after resize
-                    sz = child->getSize();
-                    break;
-                default:
-                    crossPos = crossStart;
-                    break;
+    // ── Freeze loop (CSS Flexbox §9.7) over items [first, last) ───────────
+    static void resolveLine(Scratch& s, std::size_t first, std::size_t last,
+                            float avail, float gap, std::vector<float>& target) {
+        const float gaps = gap * static_cast<float>(last - first - 1);
+
+        float hypoSum = 0.f;
+        for (std::size_t i = first; i < last; ++i) hypoSum += s.hypo[i];
+        const bool growing = hypoSum + gaps < avail;
+        const std::vector<float>& factor = growing ? s.grow : s.shrink;
+
+        // Inflexible items are frozen at their hypothetical size
+        s.frozen.resize(s.hypo.size());
+        s.violation.resize(s.hypo.size());
+        float initialFree = avail - gaps;
+        for (std::size_t i = first; i < last; ++i) {
+            const bool fixed = factor[i] == 0.f
+                            || (growing  && s.base[i] > s.hypo[i])
+                            || (!growing && s.base[i] < s.hypo[i]);
+            s.frozen[i] = fixed;
+            target[i]   = fixed ? s.hypo[i] : s.base[i];
+            initialFree -= target[i];
+        }
+
+        for (;;) {
+            float free = avail - gaps, factors = 0.f, scaled = 0.f;
+            bool  open = false;
+            for (std::size_t i = first; i < last; ++i) {
+                if (s.frozen[i]) { free -= target[i]; continue; }
+                free    -= s.base[i];
+                factors += factor[i];
+                scaled  += s.shrink[i] * s.base[i];
+                open     = true;
             }
+            if (!open) break;
+            // Factors summing below 1 take only that fraction of the space
+            if (factors < 1.f && std::abs(initialFree * factors) < std::abs(free))
+                free = initialFree * factors;
 
-            // Place child
-            if (isColumn)
-                child->setPosition({ crossPos, cursor });
-            else
-                child->setPosition({ cursor, crossPos });
+            float total = 0.f;
+            for (std::size_t i = first; i < last; ++i) {
+                if (s.frozen[i]) continue;
+                float t = s.base[i];
+                if (growing)           t += free * s.grow[i] / factors;
+                else if (scaled > 0.f) t += free * s.shrink[i] * s.base[i] / scaled;
+                const float clamped = std::max({ 0.f, s.min[i], std::min(t, s.max[i]) });
+                s.violation[i] = clamped - t;
+                total         += clamped - t;
+                target[i]      = clamped;
+            }
 
-            // Advance cursor: main size + gap + justify extra spacing
-            float mainEl = isColumn ? sz.y : sz.x;
-            cursor += mainEl + gap + between;
+            // No violation: done. Otherwise freeze the min (or max) violators
+            for (std::size_t i = first; i < last; ++i) {
+                if (s.frozen[i]) continue;
+                if (total == 0.f || (total > 0.f && s.violation[i] > 0.f) || (total < 0.f && s.violation[i] < 0.f))
+                    s.frozen[i] = 1;
+            }
+            if (total == 0.f) break;
         }
     }
 
+    // ── Own size across layouts ───────────────────────────────────────────
+    // Still the size the last layout gave it → the size from before;
+    // anything else was set by the item's own style and becomes its size
+    static sf::Vector2f naturalSize(const void* native, sf::Vector2f current) {
+        const auto it = naturals().find(native);
+        if (it == naturals().end()) return current;
+        return { current.x == it->second.assigned.x ? it->second.size.x : current.x,
+                 current.y == it->second.assigned.y ? it->second.size.y : current.y };
+    }
+
+    static void remember(const void* native, sf::Vector2f natural, sf::Vector2f assigned) {
+        if (assigned == natural) naturals().erase(native);
+        else                     naturals()[native] = { natural, assigned };
+    }
+
     // ── No flex — just offset children by padding ─────────────────────────
+    // A child still where the last offset put it is offset again from the
+    // position it had before; anything else was set by its own style
 
     static void applyPaddingOffset(
         const contracts::StyleContext& ctx,
@@ -162,9 +531,14 @@ private:
             ctx.self->getPosition().y + ctx.box.paddingTop
         };
 
+        auto& placed = offsets();
         for (auto& child : children) {
             sf::Vector2f p = child->getPosition();
-            child->setPosition({ origin.x + p.x, origin.y + p.y });
+            const auto it = placed.find(child->native());
+            if (it != placed.end() && it->second.placed == p) p = it->second.own;
+            const sf::Vector2f to{ origin.x + p.x, origin.y + p.y };
+            placed[child->native()] = { p, to };
+            child->setPosition(to);
         }
     }
 };
@@ -0,0 +1,496 @@
+#pragma once
+#include "../contracts/Types.hpp"
+#include "../utilities/Trace.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace core {
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  GridLayout
+//
+//  Implements a subset of CSS Grid Layout for SFML elements.
+//
+//  Supported features:
+//    grid-template-columns / -rows   px, %, vw, vh, fr, auto, minmax(),
+//                                    repeat(n, ...), repeat(auto-fill, ...)
+//    grid-auto-columns / -rows       size of implicit tracks
+//    grid-auto-flow                  row | column (sparse)
+//    grid-column / grid-row          "2", "2 / 4", "span 2", "1 / -1"
+//    grid-area                       "row / column / row-end / column-end"
+//    gap, row-gap, column-gap
+//    justify-items / align-items     start | end | center | stretch
+//
+//  Pipeline, over flat per-item and per-track arrays:
+//    1. place    — definite items first, then auto-placement through an
+//                  occupancy bitmap, growing implicit tracks as needed
+//    2. measure  — content contribution of every single-span item to its
+//                  column and row (auto tracks size to the largest one)
+//    3. size     — base sizes, growth up to minmax() limits, then fr
+//                  distribution (tracks whose base exceeds their fr share
+//                  are frozen), auto tracks stretch when no fr track exists
+//    4. position — items are moved (or stretched) only when their target
+//                  differs from where they already are
+//
+//  Step 3 is cached per container: when the track list, the contributions,
+//  the inner size and the gaps are unchanged the previous sizes are reused,
+//  so adding a cell that doesn't become the largest in its track resizes
+//  nothing and only the new cell is positioned.
+//
+//  Limitations vs. CSS spec:
+//    • "1fr" is minmax(0, 1fr) — fr tracks ignore content minimums
+//    • items spanning several tracks don't contribute to auto track sizes
+//    • no named lines / grid-template-areas, no dense packing, no
+//      justify-content / align-content (tracks start at the padding edge)
+//    • auto-fit behaves as auto-fill (empty repetitions are not collapsed)
+//    • items keep their size by default (justify/align-items: start), since
+//      SFML elements always have an explicit size
+//
+//  Item placement is declared on the item (grid-column …) and kept here,
+//  keyed by the wrapped SFML object, until the container lays it out.
+//  Placements and caches are per thread, like FlexLayout's.
+// ─────────────────────────────────────────────────────────────────────────────
+
+struct GridLayout {
+
+    // ── Item placement (written while styling the item) ───────────────────
+    static contracts::GridPlacement& placement(const void* native) {
+        return placements()[native];
+    }
+
+    [[nodiscard]] static const contracts::GridPlacement* findPlacement(const void* native) {
+        const auto it = placements().find(native);
+        return it != placements().end() ? &it->second : nullptr;
+    }
+
+    // Replaces this thread's placement with a copy taken on another thread
+    // (AsyncLayout); nullopt drops it
+    static void adopt(const void* native, const std::optional<contracts::GridPlacement>& p) {
+        if (p) placements()[native] = *p;
+        else   placements().erase(native);
+    }
+
+    static void forget(const void* native) {
+        placements().erase(native);
+        caches().erase(native);
+    }
+
+    static void apply(
+        const contracts::StyleContext& ctx,
+        contracts::StyleableList&      children
+    ) {
+        CSS_TRACE_ZONE("GridLayout::apply");
+        if (children.empty()) return;
+
+        const auto& g = ctx.grid;
+        const sf::Vector2f pos  = ctx.self->getPosition();
+        const sf::Vector2f size = ctx.self->getSize();
+        const sf::Vector2f inner   = ctx.box.innerSize(size);
+        const sf::Vector2f origin  = pos + ctx.box.paddingOffset();
+
+        Cache& cache = caches()[ctx.self->native()];
+        Scratch& s   = scratch();
+
+        // 1. Explicit tracks, then placement (may add implicit tracks)
+        tracks(g, inner, children, s);
+
+        // 2. Content contributions of single-span items
+        const std::size_t n = children.size();
+        contribute(children, s);
+
+        // 3. Track sizing, reused when its inputs didn't change
+        cache.columns.size(s.colTracks, s.colContent, inner.x, g.columnGap);
+        cache.rows   .size(s.rowTracks, s.rowContent, inner.y, g.rowGap);
+
+        // 4. Position
+        for (std::size_t i = 0; i < n; ++i) {
+            const float x = origin.x + cache.columns.offset[s.col[i]];
+            const float y = origin.y + cache.rows.offset[s.row[i]];
+            const float w = cache.columns.extent(s.col[i], s.colSpan[i]);
+            const float h = cache.rows.extent(s.row[i], s.rowSpan[i]);
+
+            sf::Vector2f sz = s.sizes[i];
+            if (g.justifyItems == contracts::GridTemplate::Align::Stretch) sz.x = w;
+            if (g.alignItems   == contracts::GridTemplate::Align::Stretch) sz.y = h;
+            if (sz != s.sizes[i]) children[i]->setSize(sz);
+
+            const sf::Vector2f target{
+                x + alignOffset(g.justifyItems, w, sz.x),
+                y + alignOffset(g.alignItems,   h, sz.y)
+            };
+            if (children[i]->getPosition() != target) children[i]->setPosition(target);
+        }
+    }
+
+    // Content box the grid needs: every track at its content size (fr and
+    // auto tracks fit their largest single-span item, % tracks count as 0,
+    // auto-fill repeats once), plus the gaps
+    static sf::Vector2f measure(
+        const contracts::StyleContext& ctx,
+        const contracts::StyleableList& children
+    ) {
+        CSS_TRACE_ZONE("GridLayout::measure");
+        const auto& g = ctx.grid;
+        Cache& cache = caches()[ctx.self->native()];
+        Scratch& s   = scratch();
+        tracks(g, { 0.f, 0.f }, children, s);
+        contribute(children, s);
+        cache.measuredColumns.size(s.colTracks, s.colContent, 0.f, g.columnGap);
+        cache.measuredRows   .size(s.rowTracks, s.rowContent, 0.f, g.rowGap);
+        return { cache.measuredColumns.total(), cache.measuredRows.total() };
+    }
+
+private:
+    // ── Track sizing (one axis) ───────────────────────────────────────────
+    struct Axis {
+        // Inputs of the last sizing run
+        std::vector<contracts::GridTrack> tracks;
+        std::vector<float>                content;
+        float                             avail = -1.f;
+        float                             gap   = -1.f;
+
+        // Outputs
+        std::vector<float> track;     // size per track
+        std::vector<float> offset;    // start per track, relative to the padding edge
+
+        [[nodiscard]] float total() const {
+            return track.empty() ? 0.f : offset.back() + track.back();
+        }
+
+        [[nodiscard]] float extent(int first, int span) const {
+            const int last = first + span - 1;
+            return offset[last] + track[last] - offset[first];
+        }
+
+        void size(const std::vector<contracts::GridTrack>& t, const std::vector<float>& c,
+                  float a, float g) {
+            if (a == avail && g == gap && t == tracks && c == content) return;
+            tracks = t; content = c; avail = a; gap = g;
+            GridLayout::sizeTracks(tracks, content, avail, gap, track);
+
+            offset.resize(track.size());
+            float cursor = 0.f;
+            for (std::size_t i = 0; i < track.size(); ++i) {
+                offset[i] = cursor;
+                cursor   += track[i] + gap;
+            }
+        }
+    };
+
+    struct Cache {
+        Axis columns;
+        Axis rows;
+        Axis measuredColumns;       // measure(): content-sized tracks
+        Axis measuredRows;
+    };
+
+    // Per-call working arrays, reused across calls to avoid reallocating
+    struct Scratch {
+        std::vector<contracts::GridTrack> colTracks, rowTracks;
+        std::vector<int>          col, row, colSpan, rowSpan;   // 0-based area per item
+        std::vector<sf::Vector2f> sizes;
+        std::vector<float>        colContent, rowContent;
+        std::vector<std::uint8_t> occupied;                     // minor × major bitmap
+        int                       colCount = 0, rowCount = 0;
+    };
+
+    static std::unordered_map<const void*, contracts::GridPlacement>& placements() {
+        thread_local std::unordered_map<const void*, contracts::GridPlacement> p;
+        return p;
+    }
+
+    static std::unordered_map<const void*, Cache>& caches() {
+        thread_local std::unordered_map<const void*, Cache> c;
+        return c;
+    }
+
+    static Scratch& scratch() {
+        thread_local Scratch s;
+        return s;
+    }
+
+    // Explicit tracks expanded for `inner`, then placement (which may add
+    // implicit tracks)
+    static void tracks(const contracts::GridTemplate& g, sf::Vector2f inner,
+                       const contracts::StyleableList& children, Scratch& s) {
+        expand(g.columns, inner.x, g.columnGap, s.colTracks);
+        expand(g.rows,    inner.y, g.rowGap,    s.rowTracks);
+        place(g, children, s);
+
+        while (static_cast<int>(s.colTracks.size()) < s.colCount) s.colTracks.push_back(g.autoColumns);
+        while (static_cast<int>(s.rowTracks.size()) < s.rowCount) s.rowTracks.push_back(g.autoRows);
+    }
+
+    // Largest size among the single-span items of every track
+    static void contribute(const contracts::StyleableList& children, Scratch& s) {
+        const std::size_t n = children.size();
+        s.sizes.resize(n);
+        s.colContent.assign(s.colTracks.size(), 0.f);
+        s.rowContent.assign(s.rowTracks.size(), 0.f);
+        for (std::size_t i = 0; i < n; ++i) {
+            s.sizes[i] = children[i]->getSize();
+            if (s.colSpan[i] == 1) s.colContent[s.col[i]] = std::max(s.colContent[s.col[i]], s.sizes[i].x);
+            if (s.rowSpan[i] == 1) s.rowContent[s.row[i]] = std::max(s.rowContent[s.row[i]], s.sizes[i].y);
+        }
+    }
+
+    // ── repeat(auto-fill, ...) expansion ──────────────────────────────────
+    static void expand(const contracts::GridTrackList& list, float avail, float gap,
+                       std::vector<contracts::GridTrack>& out) {
+        out = list.tracks;
+        if (list.autoRepeat.empty()) return;
+
+        // Definite size of a track for counting repetitions
+        auto definite = [avail](const contracts::GridTrack& t) {
+            auto of = [avail](const contracts::GridTrackSize& s) {
+                using K = contracts::GridTrackSize::Kind;
+                if (s.kind == K::Fixed)   return s.value;
+                if (s.kind == K::Percent) return s.value * avail;
+                return -1.f;
+            };
+            const float m = of(t.max);
+            return std::max(0.f, m >= 0.f ? m : of(t.min));
+        };
+
+        float used = 0.f, group = 0.f;
+        for (const auto& t : list.tracks)     used  += definite(t);
+        for (const auto& t : list.autoRepeat) group += definite(t);
+
+        const float T   = static_cast<float>(list.tracks.size());
+        const float R   = static_cast<float>(list.autoRepeat.size());
+        const float per = group + gap * R;
+        int reps = 1;
+        if (per > 0.f && avail > 0.f)
+            reps = std::clamp(static_cast<int>((avail - used - gap * (T - 1.f)) / per), 1, 10000);
+
+        const auto at = out.begin() + static_cast<std::ptrdiff_t>(std::min(list.repeatAt, out.size()));
+        std::vector<contracts::GridTrack> repeated;
+        repeated.reserve(list.autoRepeat.size() * static_cast<std::size_t>(reps));
+        for (int i = 0; i < reps; ++i)
+            repeated.insert(repeated.end(), list.autoRepeat.begin(), list.autoRepeat.end());
+        out.insert(at, repeated.begin(), repeated.end());
+    }
+
+    // ── Placement ─────────────────────────────────────────────────────────
+
+    // 0-based start of a definite line, or -1 for auto; `span` is updated.
+    static int resolveLine(const contracts::GridLine& l, int explicitCount, int& span) {
+        auto norm = [explicitCount](int line) {
+            return line < 0 ? std::max(1, explicitCount + 2 + line) : line;
+        };
+        int s = l.start ? norm(l.start) : 0;
+        int e = l.end   ? norm(l.end)   : 0;
+        span = std::max(1, l.span);
+
+        if (s > 0 && e > 0) {
+            if (e < s) std::swap(s, e);
+            span = std::max(1, e - s);
+            return s - 1;
+        }
+        if (s > 0) return s - 1;
+        if (e > 0) return std::max(0, e - 1 - span);
+        return -1;
+    }
+
+    static void place(const contracts::GridTemplate& g, const contracts::StyleableList& children,
+                      Scratch& s) {
+        const std::size_t n = children.size();
+        s.col.assign(n, -1);     s.row.assign(n, -1);
+        s.colSpan.assign(n, 1);  s.rowSpan.assign(n, 1);
+
+        const int explicitCols = static_cast<int>(s.colTracks.size());
+        const int explicitRows = static_cast<int>(s.rowTracks.size());
+
+        auto& all = placements();
+        for (std::size_t i = 0; i < n; ++i) {
+            auto it = all.find(children[i]->native());
+            if (it == all.end()) continue;
+            s.col[i] = resolveLine(it->second.column, explicitCols, s.colSpan[i]);
+            s.row[i] = resolveLine(it->second.row,    explicitRows, s.rowSpan[i]);
+        }
+
+        // Work in (minor, major): minor is the axis auto-placement fills
+        // first (columns for row flow), major grows as items are added.
+        std::vector<int>& minor     = g.flowColumn ? s.row     : s.col;
+        std::vector<int>& major     = g.flowColumn ? s.col     : s.row;
+        std::vector<int>& minorSpan = g.flowColumn ? s.rowSpan : s.colSpan;
+        std::vector<int>& majorSpan = g.flowColumn ? s.colSpan : s.rowSpan;
+
+        int minorCount = std::max(1, g.flowColumn ? explicitRows : explicitCols);
+        for (std::size_t i = 0; i < n; ++i)
+            minorCount = std::max(minorCount, (minor[i] >= 0 ? minor[i] : 0) + minorSpan[i]);
+
+        int majorCount = 0;
+        s.occupied.clear();
+        auto grow = [&](int rows) {
+            if (rows <= majorCount) return;
+            majorCount = rows;
+            s.occupied.resize(static_cast<std::size_t>(majorCount) * minorCount, 0);
+        };
+        auto isFree = [&](int mi, int ma, int ms, int as) {
+            grow(ma + as);
+            for (int y = ma; y < ma + as; ++y)
+                for (int x = mi; x < mi + ms; ++x)
+                    if (s.occupied[static_cast<std::size_t>(y) * minorCount + x]) return false;
+            return true;
+        };
+        auto mark = [&](std::size_t i) {
+            grow(major[i] + majorSpan[i]);
+            for (int y = major[i]; y < major[i] + majorSpan[i]; ++y)
+                for (int x = minor[i]; x < minor[i] + minorSpan[i]; ++x)
+                    s.occupied[static_cast<std::size_t>(y) * minorCount + x] = 1;
+        };
+
+        // Fully definite items first
+        for (std::size_t i = 0; i < n; ++i)
+            if (minor[i] >= 0 && major[i] >= 0) mark(i);
+
+        // Then the rest in order, with a sparse cursor
+        int curMajor = 0, curMinor = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            if (minor[i] >= 0 && major[i] >= 0) continue;
+
+            if (major[i] >= 0) {                          // locked to a row (column flow: column)
+                int x = 0;
+                while (x + minorSpan[i] <= minorCount && !isFree(x, major[i], minorSpan[i], majorSpan[i])) ++x;
+                minor[i] = x + minorSpan[i] <= minorCount ? x : 0;
+            } else if (minor[i] >= 0) {                   // locked to a column
+                if (minor[i] < curMinor) ++curMajor;
+                int y = curMajor;
+                while (!isFree(minor[i], y, minorSpan[i], majorSpan[i])) ++y;
+                major[i] = y;
+                curMajor = y;
+                curMinor = minor[i] + minorSpan[i];
+            } else {
+                for (;;) {
+                    if (curMinor + minorSpan[i] > minorCount) { ++curMajor; curMinor = 0; }
+                    if (isFree(curMinor, curMajor, minorSpan[i], majorSpan[i])) break;
+                    ++curMinor;
+                }
+                minor[i] = curMinor;
+                major[i] = curMajor;
+                curMinor += minorSpan[i];
+            }
+            mark(i);
+        }
+
+        const int minorTotal = minorCount;
+        const int majorTotal = std::max(majorCount, g.flowColumn ? explicitCols : explicitRows);
+        s.colCount = std::max(g.flowColumn ? majorTotal : minorTotal, explicitCols);
+        s.rowCount = std::max(g.flowColumn ? minorTotal : majorTotal, explicitRows);
+    }
+
+    // ── Sizing ────────────────────────────────────────────────────────────
+    static void sizeTracks(const std::vector<contracts::GridTrack>& tracks,
+                           const std::vector<float>& content,
+                           float avail, float gap, std::vector<float>& out) {
+        using K = contracts::GridTrackSize::Kind;
+        const std::size_t n = tracks.size();
+        out.assign(n, 0.f);
+        if (n == 0) return;
+
+        const bool definite = avail > 0.f;
+        auto resolve = [&](const contracts::GridTrackSize& s, std::size_t i) {
+            switch (s.kind) {
+                case K::Fixed:   return s.value;
+                case K::Percent: return s.value * std::max(0.f, avail);
+                case K::Auto:    return content[i];
+                case K::Fr:      return definite ? 0.f : content[i];
+            }
+            return 0.f;
+        };
+
+        // Base sizes and growth limits
+        std::vector<float> limit(n);
+        float frTotal = 0.f;
+        bool  anyFr   = false;
+        for (std::size_t i = 0; i < n; ++i) {
+            out[i] = resolve(tracks[i].min, i);
+            if (tracks[i].max.kind == K::Fr) {
+                limit[i] = definite ? out[i] : std::max(out[i], content[i]);
+                frTotal += tracks[i].max.value;
+                anyFr    = true;
+            } else {
+                limit[i] = std::max(out[i], resolve(tracks[i].max, i));
+            }
+        }
+        if (!definite) {
+            for (std::size_t i = 0; i < n; ++i) out[i] = limit[i];
+            return;
+        }
+
+        const float gaps = gap * static_cast<float>(n - 1);
+        auto freeSpace = [&] {
+            float used = gaps;
+            for (float v : out) used += v;
+            return avail - used;
+        };
+
+        // Grow tracks towards their limits, equally, until space runs out
+        float free = freeSpace();
+        while (free > 0.01f) {
+            std::size_t growable = 0;
+            for (std::size_t i = 0; i < n; ++i) if (out[i] < limit[i]) ++growable;
+            if (growable == 0) break;
+
+            const float share = free / static_cast<float>(growable);
+            for (std::size_t i = 0; i < n; ++i) {
+                if (out[i] >= limit[i]) continue;
+                const float add = std::min(share, limit[i] - out[i]);
+                out[i] += add;
+                free   -= add;
+            }
+        }
+
+        if (anyFr) {
+            // Find the size of 1fr, freezing tracks whose base already exceeds their share
+            std::vector<std::uint8_t> frozen(n, 0);
+            float leftover = avail - gaps;
+            for (std::size_t i = 0; i < n; ++i)
+                if (tracks[i].max.kind != K::Fr) leftover -= out[i];
+
+            float frSize = 0.f;
+            for (bool changed = true; changed;) {
+                changed = false;
+                frSize  = std::max(0.f, leftover) / std::max(frTotal, 1.f);
+                for (std::size_t i = 0; i < n; ++i) {
+                    if (tracks[i].max.kind != K::Fr || frozen[i]) continue;
+                    if (out[i] > frSize * tracks[i].max.value) {
+                        frozen[i] = 1;
+                        leftover -= out[i];
+                        frTotal  -= tracks[i].max.value;
+                        changed   = true;
+                    }
+                }
+            }
+            for (std::size_t i = 0; i < n; ++i)
+                if (tracks[i].max.kind == K::Fr && !frozen[i])
+                    out[i] = frSize * tracks[i].max.value;
+            return;
+        }
+
+        // No fr tracks: auto tracks absorb what is left
+        free = freeSpace();
+        if (free <= 0.f) return;
+        std::size_t autos = 0;
+        for (const auto& t : tracks) if (t.max.kind == K::Auto) ++autos;
+        if (autos == 0) return;
+        const float share = free / static_cast<float>(autos);
+        for (std::size_t i = 0; i < n; ++i)
+            if (tracks[i].max.kind == K::Auto) out[i] += share;
+    }
+
+    static float alignOffset(contracts::GridTemplate::Align a, float area, float item) {
+        using A = contracts::GridTemplate::Align;
+        switch (a) {
+            case A::End:    return area - item;
+            case A::Center: return (area - item) / 2.f;
+            default:        return 0.f;
+        }
+    }
+};
+
+} // namespace core
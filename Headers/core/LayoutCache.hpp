@@ -0,0 +1,147 @@
+#pragma once
+#include "../utilities/MappedFile.hpp"
+#include "../utilities/Trace.hpp"
+#include <SFML/System/Vector2.hpp>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace core {
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  LayoutCache
+//
+//  Layout results of a deferred flush kept on disk (CSS::useLayoutCache),
+//  so a static screen built the same way on every launch skips its layout:
+//
+//    key       stylesheet hash — every element's merged rules, in order,
+//                                and what each var() in them resolved to
+//              tree hash       — element kinds, parents and children, and
+//                                each element's size, position and scale
+//                                after styling (what the layout starts
+//                                from: text, images, transforms)
+//              viewport        — the window size
+//    payload   position, size and scale of every element the flush
+//              touched, in the order it first met them
+//
+//  load() maps the file (MappedFile) and copies the payload out only when
+//  all three parts of the key match; save() rewrites the file after a miss.
+//  A file that is missing, truncated or from another version is a miss.
+//
+//  use() arms the cache for one flush — the build it was set up for —
+//  and take() disarms it, so flushes made later at runtime neither look
+//  the file up nor overwrite the stored layout.
+// ─────────────────────────────────────────────────────────────────────────────
+
+struct LayoutCache {
+    struct Key {
+        std::uint64_t styles = 0;
+        std::uint64_t tree   = 0;
+        sf::Vector2f  viewport;
+
+        bool operator==(const Key& o) const {
+            return styles == o.styles && tree == o.tree && viewport == o.viewport;
+        }
+    };
+
+    struct Geometry {
+        sf::Vector2f position;
+        sf::Vector2f size;
+        sf::Vector2f scale;
+    };
+    static_assert(sizeof(Geometry) == 6 * sizeof(float), "Geometry is stored as six floats");
+
+    // FNV-1a, fed field by field
+    class Hasher {
+    public:
+        void add(const void* data, std::size_t n) {
+            const auto* p = static_cast<const unsigned char*>(data);
+            for (std::size_t i = 0; i < n; ++i) {
+                h_ ^= p[i];
+                h_ *= 0x100000001b3ull;
+            }
+        }
+        void add(const std::string& s) { add(s.data(), s.size()); add(std::uint64_t{ s.size() }); }
+        void add(std::uint64_t v)       { add(&v, sizeof v); }
+        void add(sf::Vector2f v)        { add(&v.x, sizeof v.x); add(&v.y, sizeof v.y); }
+
+        [[nodiscard]] std::uint64_t value() const { return h_; }
+
+    private:
+        std::uint64_t h_ = 0xcbf29ce484222325ull;
+    };
+
+    // Arms the cache for the next flush; empty turns it off
+    static void use(const std::string& path) {
+        file()  = path;
+        armed() = !path.empty();
+    }
+
+    // Whether this flush is the one to cache; true once per use()
+    [[nodiscard]] static bool take() { return std::exchange(armed(), false); }
+
+    static bool load(const Key& key, std::vector<Geometry>& out) {
+        CSS_TRACE_ZONE("LayoutCache::load");
+        utilities::MappedFile mapped;
+        if (file().empty() || !mapped.open(file()) || mapped.size() < sizeof(Header)) return false;
+
+        Header h;
+        std::memcpy(&h, mapped.data(), sizeof h);
+        if (std::memcmp(h.magic, kMagic, sizeof h.magic) != 0 || h.version != kVersion) return false;
+        if (!(Key{ h.styles, h.tree, { h.viewportX, h.viewportY } } == key)) return false;
+        if (mapped.size() != sizeof(Header) + std::size_t{ h.count } * sizeof(Geometry)) return false;
+
+        out.resize(h.count);
+        std::memcpy(out.data(), static_cast<const char*>(mapped.data()) + sizeof h, h.count * sizeof(Geometry));
+        return true;
+    }
+
+    static bool save(const Key& key, const std::vector<Geometry>& geometry) {
+        CSS_TRACE_ZONE("LayoutCache::save");
+        if (file().empty()) return false;
+        Header h;
+        std::memcpy(h.magic, kMagic, sizeof h.magic);
+        h.version   = kVersion;
+        h.styles    = key.styles;
+        h.tree      = key.tree;
+        h.viewportX = key.viewport.x;
+        h.viewportY = key.viewport.y;
+        h.count     = static_cast<std::uint32_t>(geometry.size());
+
+        std::ofstream outFile(file(), std::ios::binary | std::ios::trunc);
+        outFile.write(reinterpret_cast<const char*>(&h), sizeof h);
+        outFile.write(reinterpret_cast<const char*>(geometry.data()),
+                      static_cast<std::streamsize>(geometry.size() * sizeof(Geometry)));
+        return static_cast<bool>(outFile);
+    }
+
+private:
+    static constexpr char          kMagic[4] = { 'C', 'S', 'L', 'C' };
+    static constexpr std::uint32_t kVersion  = 1;
+
+    struct Header {
+        char          magic[4];
+        std::uint32_t version;
+        std::uint64_t styles;
+        std::uint64_t tree;
+        float         viewportX;
+        float         viewportY;
+        std::uint32_t count;
+        std::uint32_t reserved = 0;
+    };
+
+    static std::string& file() {
+        static std::string path;
+        return path;
+    }
+
+    static bool& armed() {
+        static bool on = false;
+        return on;
+    }
+};
+
+} // namespace core
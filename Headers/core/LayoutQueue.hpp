@@ -0,0 +1,166 @@
+#pragma once
+#include "../contracts/Types.hpp"
+#include "../utilities/Trace.hpp"
+#include "ElementRegistry.hpp"
+#include "StyleEngine.hpp"
+#include <SFML/Graphics/RenderWindow.hpp>
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace core {
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  LayoutQueue
+//
+//  Style() calls recorded for later (CSS::queue) and run a time slice at a
+//  time (CSS::layoutFor), so building a large screen spreads over several
+//  frames instead of stalling one.
+//
+//  Jobs run in the order they were queued, through the same
+//  StyleEngine::style() a Style() call uses, so once the queue is empty the
+//  result is exactly that of calling Style() in that order. A job is the
+//  unit of work: a container's layout is never split, and a slice always
+//  runs at least one job so a small budget still makes progress.
+//
+//  An element queued before it was ever styled — its own job or a child of
+//  a queued container — stays out of drawAll() until every queued job that
+//  styles or places it ran: queue children before their container and each
+//  finished subtree appears at once, in one piece. Elements already on
+//  screen keep drawing their previous style meanwhile.
+// ─────────────────────────────────────────────────────────────────────────────
+
+struct LayoutQueue {
+    struct Job {
+        contracts::Styleable                    self;
+        std::vector<std::string>                rules;
+        std::optional<contracts::Styleable>     parent;
+        std::optional<contracts::StyleableList> children;
+    };
+
+    struct Progress {
+        std::size_t completed = 0;      // jobs run since the queue was last empty
+        std::size_t remaining = 0;
+
+        [[nodiscard]] bool finished() const { return remaining == 0; }
+        [[nodiscard]] float fraction() const {
+            const std::size_t total = completed + remaining;
+            return total ? static_cast<float>(completed) / static_cast<float>(total) : 1.f;
+        }
+    };
+
+    static void push(Job job) {
+        auto& s = state();
+        hold(job.self->native());
+        if (job.children)
+            for (const auto& child : *job.children) hold(child->native());
+        s.jobs.push_back(std::move(job));
+    }
+
+    // Runs queued jobs until `budget` is spent (at least one)
+    static Progress run(std::chrono::microseconds budget, sf::RenderWindow& window) {
+        CSS_TRACE_ZONE("LayoutQueue::run");
+        auto& s = state();
+        const auto start = std::chrono::steady_clock::now();
+        while (!s.jobs.empty()) {
+            Job job = std::move(s.jobs.front());
+            s.jobs.pop_front();
+            StyleEngine::style(job.self, job.rules, job.parent,
+                               job.children ? &*job.children : nullptr, window);
+            settle(job.self->native());
+            if (job.children)
+                for (const auto& child : *job.children) settle(child->native());
+            ++s.completed;
+            if (std::chrono::steady_clock::now() - start >= budget) break;
+        }
+        const Progress p = progress();
+        if (s.jobs.empty()) s.completed = 0;
+        return p;
+    }
+
+    [[nodiscard]] static Progress progress() {
+        const auto& s = state();
+        return { s.completed, s.jobs.size() };
+    }
+
+    [[nodiscard]] static bool empty() { return state().jobs.empty(); }
+
+    // Queued, and not drawn until its jobs ran
+    [[nodiscard]] static bool hidden(const void* native) {
+        const auto& pending = state().pending;
+        if (pending.empty()) return false;
+        const auto it = pending.find(native);
+        return it != pending.end() && it->second.hidden;
+    }
+
+    // Drops the element's jobs and its place in queued child lists; the
+    // children a dropped job held are released as if it had run
+    static void forget(const void* native) {
+        auto& s = state();
+        if (s.pending.empty()) return;
+        s.jobs.erase(std::remove_if(s.jobs.begin(), s.jobs.end(),
+                                    [native](const Job& j) {
+                                        if (j.self->native() != native) return false;
+                                        settle(native);
+                                        if (j.children)
+                                            for (const auto& child : *j.children) settle(child->native());
+                                        return true;
+                                    }),
+                     s.jobs.end());
+        for (Job& j : s.jobs) {
+            if (j.parent && (*j.parent)->native() == native) j.parent.reset();
+            if (j.children)
+                j.children->erase(std::remove_if(j.children->begin(), j.children->end(),
+                                                 [native](const contracts::Styleable& c) {
+                                                     if (c->native() != native) return false;
+                                                     settle(native);
+                                                     return true;
+                                                 }),
+                                  j.children->end());
+        }
+        s.pending.erase(native);
+        if (s.jobs.empty()) s.completed = 0;
+    }
+
+    static void clear() {
+        auto& s = state();
+        s.jobs.clear();
+        s.pending.clear();
+        s.completed = 0;
+    }
+
+private:
+    struct Pending {
+        std::size_t jobs   = 0;
+        bool        hidden = false;
+    };
+
+    struct State {
+        std::deque<Job>                             jobs;
+        std::unordered_map<const void*, Pending>    pending;
+        std::size_t                                 completed = 0;
+    };
+
+    static State& state() {
+        static State s;
+        return s;
+    }
+
+    // One more queued job styles or places the element
+    static void hold(const void* native) {
+        Pending& p = state().pending[native];
+        if (p.jobs++ == 0) p.hidden = ElementRegistry::find(native) == ElementRegistry::kInvalid;
+    }
+
+    static void settle(const void* native) {
+        auto& pending = state().pending;
+        const auto it = pending.find(native);
+        if (it != pending.end() && --it->second.jobs == 0) pending.erase(it);
+    }
+};
+
+} // namespace core
@@ -0,0 +1,115 @@
+#pragma once
+#include "../contracts/Types.hpp"
+#include "../utilities/MpscRing.hpp"
+#include "../utilities/Trace.hpp"
+#include "RuleParser.hpp"
+#include "StyleEngine.hpp"
+#include <SFML/Graphics/RenderWindow.hpp>
+#include <algorithm>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace core {
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  PostQueue
+//
+//  Style changes posted from any thread (CSS::post) and applied on the
+//  render thread (CSS::applyPosted), once per frame.
+//
+//  post() parses the rule on the calling thread and pushes the declaration
+//  into a bounded lock-free MpscRing — no lock, no SFML call; when the ring
+//  is full it fails rather than wait. drain() pops everything, keeps only
+//  the last value posted for each element and property, and hands each
+//  element's changes to StyleEngine::amend() in one go, in the order the
+//  elements were first posted to.
+// ─────────────────────────────────────────────────────────────────────────────
+
+struct PostQueue {
+    static constexpr std::size_t kCapacity = 4096;
+
+    struct Command {
+        contracts::Styleable    target;
+        contracts::Declaration  decl;
+    };
+
+    // Any thread; false when the rule doesn't parse or the queue is full
+    static bool post(contracts::Styleable target, const std::string& rule) {
+        auto decls = RuleParser::parse({ rule });
+        if (decls.size() != 1) return false;
+        return post(std::move(target), std::move(decls.front()));
+    }
+
+    static bool post(contracts::Styleable target, contracts::Declaration decl) {
+        return ring().push({ std::move(target), std::move(decl) });
+    }
+
+    // Render thread; returns how many elements changed
+    static std::size_t drain(sf::RenderWindow& window) {
+        CSS_TRACE_ZONE("PostQueue::drain");
+        Batch& b = collect();
+        std::size_t changed = 0;
+        for (auto& u : b.updates) {
+            if (!u.target.valid()) continue;
+            StyleEngine::amend(std::move(u.target), std::move(u.decls), window);
+            ++changed;
+        }
+        b.updates.clear();
+        b.slot.clear();
+        return changed;
+    }
+
+    // Render thread; drops what was posted to the element so far
+    static void forget(const void* native) {
+        Batch& b = collect();
+        const auto it = b.slot.find(native);
+        if (it == b.slot.end()) return;
+        b.updates[it->second] = {};
+        b.slot.erase(it);
+    }
+
+private:
+    struct Update {
+        contracts::Styleable                target;
+        std::vector<contracts::Declaration> decls;
+    };
+
+    // Render thread only: one frame's commands, collapsed per element
+    struct Batch {
+        std::vector<Update>                          updates;
+        std::unordered_map<const void*, std::size_t> slot;
+    };
+
+    static utilities::MpscRing<Command>& ring() {
+        static utilities::MpscRing<Command> r(kCapacity);
+        return r;
+    }
+
+    static Batch& batch() {
+        static Batch b;
+        return b;
+    }
+
+    // Moves the ring's commands into the batch, last value per property; at
+    // most one ring's worth, so producers posting meanwhile can't keep the
+    // render thread here
+    static Batch& collect() {
+        Batch& b = batch();
+        Command cmd;
+        for (std::size_t n = ring().capacity(); n > 0 && ring().pop(cmd); --n) {
+            const void* native = cmd.target->native();
+            auto [it, added] = b.slot.try_emplace(native, b.updates.size());
+            if (added) b.updates.push_back({ std::move(cmd.target), {} });
+
+            auto& decls = b.updates[it->second].decls;
+            decls.erase(std::remove_if(decls.begin(), decls.end(),
+                                       [&](const contracts::Declaration& d) { return d.property == cmd.decl.property; }),
+                        decls.end());
+            decls.push_back(std::move(cmd.decl));
+        }
+        return b;
+    }
+};
+
+} // namespace core
@@ -1,8 +1,15 @@
 #pragma once
 #include "../contracts/Types.hpp"
+#include "../utilities/CalcExpression.hpp"
 #include "../utilities/ColorParser.hpp"
+#include "../utilities/GradientParser.hpp"
+#include "../utilities/GridParser.hpp"
 #include "../utilities/LengthResolver.hpp"
 #include "../utilities/TransformParser.hpp"
+#include "../utilities/Trace.hpp"
+#include "FlexLayout.hpp"
+#include "GridLayout.hpp"
+#include <algorithm>
 #include <string>
 #include <vector>
 
@@ -13,6 +20,9 @@ namespace core {
 //
 //  Applies a list of parsed declarations to a StyleContext in two passes:
 //
+//  (Image sources — background-image / border-image url(...) — run first,
+//  since a sprite's width/height scale relative to its texture rect.)
+//
 //  Pass 1 — Intrinsic properties (size, color, font, box model, layout intent)
 //           These can be resolved purely from the declaration value and the
 //           containing block — no knowledge of other declarations needed.
@@ -30,15 +40,38 @@ struct PropertyDispatcher {
         contracts::StyleContext&                      ctx,
         const std::vector<contracts::Declaration>&    decls
     ) {
-        for (const auto& d : decls) pass1(ctx, d.property, d.value);
-        for (const auto& d : decls) pass2(ctx, d.property, d.value);
+        CSS_TRACE_COUNT_N(DeclarationsProcessed, decls.size());
+        {
+            CSS_TRACE_ZONE("PropertyDispatcher::pass1");
+            for (const auto& d : decls)
+                if (isImageSource(d)) pass1(ctx, d.property, d.value);
+            for (const auto& d : decls) {
+                if (isImageSource(d)) continue;
+                if (!pass1(ctx, d.property, d.value) && !isPositional(d.property))
+                    CSS_TRACE_COUNT(UnknownProperties);
+            }
+        }
+        {
+            CSS_TRACE_ZONE("PropertyDispatcher::pass2");
+            for (const auto& d : decls) pass2(ctx, d.property, d.value);
+        }
         flushDeferredTransforms(ctx);
     }
 
+    // Declarations that load an image file (background / border-image url)
+    static bool isImageSource(const contracts::Declaration& d) {
+        const auto& p = d.property;
+        if (p == "border-image") return SU::toLower(d.value).find("url(") != std::string::npos;
+        return (p == "background-image" || p == "background" || p == "border-image-source")
+            && isUrl(d.value);
+    }
+
 private:
     using LR  = utilities::LengthResolver;
     using CP  = utilities::ColorParser;
     using SU  = utilities::StringUtils;
+    using GP  = utilities::GridParser;
+    using CK  = contracts::ContentSizing::Keyword;
 
     // ── Helpers ───────────────────────────────────────────────────────────
 
@@ -53,7 +86,9 @@ private:
     //  PASS 1 — intrinsic properties
     // ─────────────────────────────────────────────────────────────────────
 
-    static void pass1(
+    // Returns false when the property is not an intrinsic one (either
+    // positional, handled by pass 2, or unknown to the library).
+    static bool pass1(
         contracts::StyleContext& ctx,
         const std::string&       prop,
         const std::string&       val
@@ -61,7 +96,17 @@ private:
         auto& el = ctx.self;
 
         // ── Sizing ────────────────────────────────────────────────────────
-        if (prop == "width") {
+        if (prop == "width" && contentKeyword(val) != CK::None) {
+            // Containers are sized by ContentSize once dispatch is done;
+            // texts re-wrap to their content now
+            ctx.content.width = contentKeyword(val);
+            if (el->isText() && ctx.content.width == CK::MinContent) el->wrapToMinContent();
+            else if (el->isText()) el->setSize({ textWidth(ctx.content.width, ctx), el->getSize().y });
+        }
+        else if (prop == "height" && contentKeyword(val) != CK::None) {
+            ctx.content.height = contentKeyword(val);
+        }
+        else if (prop == "width") {
             float w = resolveH(val, ctx);
             el->setSize({ w, el->getSize().y });
         }
@@ -70,7 +115,7 @@ private:
             el->setSize({ el->getSize().x, h });
         }
         else if (prop == "size") {
-            auto parts = SU::tokenize(val);
+            auto parts = SU::splitTopLevel(val, ' ');
             if (parts.size() >= 2)
                 el->setSize({ resolveH(parts[0], ctx), resolveV(parts[1], ctx) });
             else if (parts.size() == 1) {
@@ -82,18 +127,22 @@ private:
         }
         else if (prop == "min-width") {
             float w = resolveH(val, ctx);
+            FlexLayout::limits(el->native()).min.x = w;
             if (el->getSize().x < w) el->setSize({ w, el->getSize().y });
         }
         else if (prop == "max-width") {
             float w = resolveH(val, ctx);
+            FlexLayout::limits(el->native()).max.x = w;
             if (el->getSize().x > w) el->setSize({ w, el->getSize().y });
         }
         else if (prop == "min-height") {
             float h = resolveV(val, ctx);
+            FlexLayout::limits(el->native()).min.y = h;
             if (el->getSize().y < h) el->setSize({ el->getSize().x, h });
         }
         else if (prop == "max-height") {
             float h = resolveV(val, ctx);
+            FlexLayout::limits(el->native()).max.y = h;
             if (el->getSize().y > h) el->setSize({ el->getSize().x, h });
         }
         else if (prop == "radius") {
@@ -107,6 +156,20 @@ private:
         else if (prop == "background-color" || prop == "fill" || prop == "fill-color") {
             el->setFillColor(CP::parse(val));
         }
+        else if (prop == "background" || prop == "background-image") {
+            // The shorthand resets the color underneath, as in CSS
+            if (utilities::GradientParser::isGradient(val)) {
+                if (prop == "background") el->setFillColor(sf::Color::Transparent);
+                el->setBackgroundGradient(utilities::GradientParser::parse(val));
+            } else if (isUrl(val)) {
+                el->setBackgroundGradient({});
+                el->setBackgroundImage(parseUrl(val));
+            } else {
+                el->setBackgroundGradient({});
+                if (val == "none") el->setBackgroundImage({});
+                else if (prop == "background") el->setFillColor(CP::parse(val));
+            }
+        }
         else if (prop == "color") {
             // Text → fill color; shapes → outline color
             if (el->isText()) el->setFillColor(CP::parse(val));
@@ -118,6 +181,58 @@ private:
         else if (prop == "border-width") {
             el->setOutlineThickness(LR::parseAbsolute(val));
         }
+        else if (prop == "border-radius") {
+            el->setBorderRadius(parseRadius(val));
+        }
+        else if (prop == "border-top-left-radius"     || prop == "border-top-right-radius"
+              || prop == "border-bottom-right-radius" || prop == "border-bottom-left-radius") {
+            using C = contracts::BorderRadius::Corner;
+            const C corner = prop == "border-top-left-radius"     ? C::TopLeft
+                           : prop == "border-top-right-radius"    ? C::TopRight
+                           : prop == "border-bottom-right-radius" ? C::BottomRight
+                                                                  : C::BottomLeft;
+            const auto one = parseRadius(val);
+            auto r = el->getBorderRadius();
+            r.value[corner]   = one.value[0];
+            r.percent[corner] = one.percent[0];
+            el->setBorderRadius(r);
+        }
+        else if (prop == "box-shadow") {
+            el->setBoxShadow(parseBoxShadow(val));
+        }
+        else if (prop == "border-image-slice") {
+            auto n = el->getNineSlice();
+            parseImageSlice(val, n);
+            el->setNineSlice(n);
+        }
+        else if (prop == "border-image-width") {
+            auto n = el->getNineSlice();
+            parseImageWidth(val, n);
+            el->setNineSlice(n);
+        }
+        else if (prop == "border-image-source") {
+            if (isUrl(val)) el->setBackgroundImage(parseUrl(val));
+            else if (val == "none") el->setNineSlice({});
+        }
+        else if (prop == "border-image") {
+            // url(...) <slice> [fill] [/ <width> [/ <outset>]] [<repeat>] —
+            // only stretch is drawn, outset and repeat are ignored
+            std::string rest = val;
+            const size_t u = SU::toLower(rest).find("url(");
+            if (u != std::string::npos) {
+                const size_t close = rest.find(')', u);
+                const size_t end   = close == std::string::npos ? rest.size() : close + 1;
+                el->setBackgroundImage(parseUrl(rest.substr(u, end - u)));
+                rest.erase(u, end - u);
+            }
+            if (SU::trim(rest) == "none") { el->setNineSlice({}); return true; }
+            const size_t slash = rest.find('/');
+            contracts::NineSlice n;
+            parseImageSlice(rest.substr(0, slash), n);
+            if (slash != std::string::npos)
+                parseImageWidth(rest.substr(slash + 1, rest.find('/', slash + 1) - slash - 1), n);
+            el->setNineSlice(n);
+        }
         else if (prop == "opacity") {
             float alpha = std::stof(val);
             if (alpha <= 1.f) alpha *= 255.f;
@@ -145,6 +260,22 @@ private:
         else if (prop == "font-style" || prop == "text-decoration") {
             el->setTextStyle(parseTextStyle(val));
         }
+        else if (prop == "font-family") {
+            el->setFontFamily(val);
+        }
+        else if (prop == "white-space") {
+            el->setWhiteSpace(parseWhiteSpace(val));
+        }
+        else if (prop == "overflow-wrap" || prop == "word-wrap") {
+            el->setOverflowWrap(val == "break-word" || val == "anywhere"
+                ? contracts::TextWrap::OverflowWrap::BreakWord
+                : contracts::TextWrap::OverflowWrap::Normal);
+        }
+        else if (prop == "text-overflow") {
+            el->setTextOverflow(val == "ellipsis"
+                ? contracts::TextWrap::TextOverflow::Ellipsis
+                : contracts::TextWrap::TextOverflow::Clip);
+        }
 
         // ── Transform ─────────────────────────────────────────────────────
         else if (prop == "transform") {
@@ -167,7 +298,7 @@ private:
             el->setScale({ el->getScale().x, std::stof(val) });
         }
         else if (prop == "origin") {
-            auto parts = SU::tokenize(val);
+            auto parts = SU::splitTopLevel(val, ' ');
             if (parts.size() >= 2)
                 el->setOrigin({ LR::parseAbsolute(parts[0]),
                                  LR::parseAbsolute(parts[1]) });
@@ -198,19 +329,96 @@ private:
 
         // ── Flex / layout intent ──────────────────────────────────────────
         else if (prop == "display") {
-            ctx.flex.enabled = (val == "flex" || val == "grid");
+            ctx.flex.enabled = (val == "flex");
+            ctx.grid.enabled = (val == "grid");
         }
         else if (prop == "flex-direction") {
             ctx.flex.column = (val == "column" || val == "column-reverse");
         }
-        else if (prop == "gap" || prop == "row-gap" || prop == "column-gap") {
-            ctx.flex.gap = resolveH(val, ctx);
+        else if (prop == "flex-wrap") {
+            ctx.flex.wrap = (val == "wrap" || val == "wrap-reverse");
+        }
+        else if (prop == "flex-flow") {
+            for (const auto& t : SU::tokenize(val)) {
+                if (t == "row" || t == "row-reverse")            ctx.flex.column = false;
+                else if (t == "column" || t == "column-reverse") ctx.flex.column = true;
+                else if (t == "nowrap")                          ctx.flex.wrap   = false;
+                else if (t == "wrap" || t == "wrap-reverse")     ctx.flex.wrap   = true;
+            }
+        }
+
+        // ── Flex item (kept until the container lays it out) ──────────────
+        else if (prop == "flex-grow") {
+            FlexLayout::item(el->native()).grow = std::max(0.f, std::stof(val));
+        }
+        else if (prop == "flex-shrink") {
+            FlexLayout::item(el->native()).shrink = std::max(0.f, std::stof(val));
+        }
+        else if (prop == "flex-basis") {
+            parseFlexBasis(FlexLayout::item(el->native()), val, ctx);
+        }
+        else if (prop == "flex") {
+            FlexLayout::item(el->native()) = parseFlex(val, ctx);
+        }
+        else if (prop == "gap") {
+            auto parts = SU::splitTopLevel(val, ' ');
+            ctx.flex.gap = parts.empty() ? 0.f : resolveH(parts[0], ctx);
+            ctx.grid.rowGap    = parts.empty() ? 0.f : resolveV(parts[0], ctx);
+            ctx.grid.columnGap = parts.size() > 1 ? resolveH(parts[1], ctx) : ctx.flex.gap;
+        }
+        else if (prop == "row-gap") {
+            ctx.flex.gap    = resolveH(val, ctx);
+            ctx.grid.rowGap = resolveV(val, ctx);
+        }
+        else if (prop == "column-gap") {
+            ctx.flex.gap       = resolveH(val, ctx);
+            ctx.grid.columnGap = ctx.flex.gap;
         }
         else if (prop == "justify-content") {
             ctx.flex.justify = parseJustify(val);
         }
         else if (prop == "align-items") {
-            ctx.flex.align = parseAlign(val);
+            ctx.flex.align       = parseAlign(val);
+            ctx.grid.alignItems  = parseGridAlign(val);
+        }
+        else if (prop == "justify-items") {
+            ctx.grid.justifyItems = parseGridAlign(val);
+        }
+
+        // ── Grid container ────────────────────────────────────────────────
+        else if (prop == "grid-template-columns") {
+            ctx.grid.columns = GP::parseTracks(val, ctx.windowSize);
+        }
+        else if (prop == "grid-template-rows") {
+            ctx.grid.rows = GP::parseTracks(val, ctx.windowSize);
+        }
+        else if (prop == "grid-auto-columns") {
+            ctx.grid.autoColumns = GP::parseTrack(SU::toLower(val), ctx.windowSize);
+        }
+        else if (prop == "grid-auto-rows") {
+            ctx.grid.autoRows = GP::parseTrack(SU::toLower(val), ctx.windowSize);
+        }
+        else if (prop == "grid-auto-flow") {
+            ctx.grid.flowColumn = (val.find("column") != std::string::npos);
+        }
+
+        // ── Grid item placement (read by the container's GridLayout) ──────
+        else if (prop == "grid-column") {
+            GridLayout::placement(el->native()).column = GP::parseLine(val);
+        }
+        else if (prop == "grid-row") {
+            GridLayout::placement(el->native()).row = GP::parseLine(val);
+        }
+        else if (prop == "grid-column-start" || prop == "grid-column-end") {
+            GP::applySide(GridLayout::placement(el->native()).column,
+                          SU::toLower(val), prop == "grid-column-start");
+        }
+        else if (prop == "grid-row-start" || prop == "grid-row-end") {
+            GP::applySide(GridLayout::placement(el->native()).row,
+                          SU::toLower(val), prop == "grid-row-start");
+        }
+        else if (prop == "grid-area") {
+            GridLayout::placement(el->native()) = GP::parseArea(val);
         }
 
         // ── Position mode ─────────────────────────────────────────────────
@@ -220,12 +428,23 @@ private:
             else if (val == "center")   ctx.positionMode = contracts::PositionMode::Center;
             else                        ctx.positionMode = contracts::PositionMode::Default;
         }
+        else if (prop == "z-index" || prop == "overflow") {
+            // Paint order / clipping — StyleEngine records them in the registry
+        }
+        else return false;
+
+        return true;
     }
 
     // ─────────────────────────────────────────────────────────────────────
     //  PASS 2 — positional properties
     // ─────────────────────────────────────────────────────────────────────
 
+    static bool isPositional(const std::string& prop) {
+        return prop == "left" || prop == "x" || prop == "right"
+            || prop == "top"  || prop == "y" || prop == "bottom";
+    }
+
     static void pass2(
         contracts::StyleContext& ctx,
         const std::string&       prop,
@@ -296,6 +515,60 @@ private:
     //  Small enum parsers
     // ─────────────────────────────────────────────────────────────────────
 
+    static CK contentKeyword(const std::string& v) {
+        const std::string t = SU::toLower(SU::trim(v));
+        if (t == "auto")        return CK::Auto;
+        if (t == "fit-content") return CK::FitContent;
+        if (t == "min-content") return CK::MinContent;
+        if (t == "max-content") return CK::MaxContent;
+        return CK::None;
+    }
+
+    // Wrap width of a text sized by its content: 0 never wraps (max-content);
+    // min-content is left to the wrapper, which measures the widest word
+    static float textWidth(CK k, const contracts::StyleContext& ctx) {
+        return k == CK::FitContent ? ctx.parentSize.x : 0.f;
+    }
+
+    // auto | content | <length> | <percentage>
+    static void parseFlexBasis(contracts::FlexItem& item, const std::string& v,
+                               const contracts::StyleContext& ctx) {
+        const std::string t = SU::toLower(SU::trim(v));
+        item.basis.reset();
+        item.basisPercent = false;
+        if (t.empty() || t == "auto" || t == "content") return;
+        if (t.back() == '%') {
+            item.basis        = std::stof(t.substr(0, t.size() - 1));
+            item.basisPercent = true;
+        } else {
+            item.basis = std::max(0.f, resolveH(t, ctx));
+        }
+    }
+
+    // none | auto | initial | <grow> [<shrink>] [<basis>] | <basis>
+    static contracts::FlexItem parseFlex(const std::string& v, const contracts::StyleContext& ctx) {
+        contracts::FlexItem item;
+        const auto parts = SU::splitTopLevel(SU::toLower(v), ' ');
+        if (parts.size() == 1 && parts[0] == "none")    { item.shrink = 0.f; return item; }
+        if (parts.size() == 1 && parts[0] == "initial") return item;
+        if (parts.size() == 1 && parts[0] == "auto")    { item.grow = 1.f; return item; }
+
+        // A bare number sets the basis to 0, as in CSS
+        std::size_t numbers = 0;
+        bool basis = false;
+        for (const auto& t : parts) {
+            if (isPlainNumber(t) && numbers < 2) {
+                (numbers++ == 0 ? item.grow : item.shrink) = std::max(0.f, std::stof(t));
+            } else {
+                parseFlexBasis(item, t, ctx);
+                basis = true;
+            }
+        }
+        if (numbers == 0) item.grow = 1.f;
+        else if (!basis)  item.basis = 0.f;
+        return item;
+    }
+
     static contracts::FlexLayout::Justify parseJustify(const std::string& v) {
         using J = contracts::FlexLayout::Justify;
         if (v=="flex-end"   ||v=="end")            return J::End;
@@ -314,6 +587,129 @@ private:
         return A::Start;
     }
 
+    static contracts::GridTemplate::Align parseGridAlign(const std::string& v) {
+        using A = contracts::GridTemplate::Align;
+        if (v=="end" || v=="flex-end")   return A::End;
+        if (v=="center")                 return A::Center;
+        if (v=="stretch")                return A::Stretch;
+        return A::Start;
+    }
+
+    static bool isUrl(const std::string& v) {
+        return SU::toLower(SU::trim(v)).rfind("url(", 0) == 0;
+    }
+
+    // url(path), url("path"), url('path') → path
+    static std::string parseUrl(const std::string& v) {
+        std::string s = SU::trim(v);
+        const size_t open = s.find('('), close = s.rfind(')');
+        if (open == std::string::npos || close == std::string::npos || close < open) return {};
+        s = SU::trim(s.substr(open + 1, close - open - 1));
+        if (s.size() >= 2 && (s.front() == '"' || s.front() == '\'') && s.back() == s.front())
+            s = s.substr(1, s.size() - 2);
+        return s;
+    }
+
+    // "8px", "8px 4px", "8px 4px 2px", "8px 4px 2px 0", "50%" — CSS corner
+    // order. The vertical half of "a / b" is ignored: percentages give
+    // elliptical corners, lengths stay circular.
+    static contracts::BorderRadius parseRadius(const std::string& val) {
+        contracts::BorderRadius r;
+        const auto halves = SU::splitTopLevel(val, '/');
+        const auto tok    = halves.empty() ? halves : SU::splitTopLevel(halves[0], ' ');
+        if (tok.empty() || tok.size() > 4) return r;
+
+        for (int c = 0; c < 4; ++c) {
+            const std::string& t = tok[sideToken(tok.size(), c)];
+            r.percent[c] = t.back() == '%';
+            r.value[c]   = std::max(0.f, r.percent[c] ? LR::resolve(t, 1.f) : LR::parseAbsolute(t));
+        }
+        return r;
+    }
+
+    // "<x> <y> [<blur> [<spread>]] [<color>]" in any order of lengths and
+    // color. Only the first of several comma-separated shadows is drawn;
+    // `inset` shadows are not supported and yield none.
+    static contracts::BoxShadow parseBoxShadow(const std::string& val) {
+        contracts::BoxShadow s;
+        const auto layers = SU::splitTopLevel(val, ',');
+        if (layers.empty() || SU::trim(layers[0]) == "none") return s;
+
+        std::vector<float> lengths;
+        bool colored = false;
+        for (const auto& t : SU::splitTopLevel(SU::trim(layers[0]), ' ')) {
+            if (t.empty()) continue;
+            if (t == "inset") return {};
+            const char c = t[0];
+            if ((c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.'
+                || utilities::CalcExpression::isExpression(t)) {
+                lengths.push_back(LR::parseAbsolute(t));
+            } else {
+                s.color = CP::parse(t);
+                colored = true;
+            }
+        }
+        if (lengths.size() < 2 || lengths.size() > 4) return {};
+        s.x      = lengths[0];
+        s.y      = lengths[1];
+        s.blur   = lengths.size() > 2 ? std::max(0.f, lengths[2]) : 0.f;
+        s.spread = lengths.size() > 3 ? lengths[3] : 0.f;
+        if (!colored) s.color = sf::Color::Black;
+        return s;
+    }
+
+    // CSS 1–4 value expansion: index of the token each side (T, R, B, L) takes
+    static int sideToken(size_t count, int side) {
+        static constexpr int from[4][4] = {
+            { 0, 0, 0, 0 }, { 0, 1, 0, 1 }, { 0, 1, 2, 1 }, { 0, 1, 2, 3 }
+        };
+        return from[count - 1][side];
+    }
+
+    static bool isPlainNumber(const std::string& t) {
+        return !t.empty() && t.find_first_not_of("0123456789.+-") == std::string::npos;
+    }
+
+    // "16", "10% 20", "8 fill" — texture px or % of the texture rect.
+    // Unknown words (stretch, round, ...) are skipped.
+    static void parseImageSlice(const std::string& val, contracts::NineSlice& n) {
+        std::vector<std::string> tok;
+        n.fill = false;
+        for (const auto& t : SU::tokenize(val)) {
+            if (t == "fill") n.fill = true;
+            else if (isPlainNumber(t) || (t.size() > 1 && t.back() == '%'
+                                          && isPlainNumber(t.substr(0, t.size() - 1))))
+                tok.push_back(t);
+        }
+        if (tok.empty() || tok.size() > 4) return;
+        for (int side = 0; side < 4; ++side) {
+            const std::string& t = tok[sideToken(tok.size(), side)];
+            n.slicePercent[side] = t.back() == '%';
+            n.slice[side] = std::max(0.f, n.slicePercent[side] ? LR::resolve(t, 1.f) : std::stof(t));
+        }
+    }
+
+    // "12px", "2", "auto" — a length, or a multiple of the slice (auto = 1)
+    static void parseImageWidth(const std::string& val, contracts::NineSlice& n) {
+        const auto tok = SU::tokenize(val);
+        if (tok.empty() || tok.size() > 4) return;
+        for (int side = 0; side < 4; ++side) {
+            const std::string& t = tok[sideToken(tok.size(), side)];
+            n.widthMultiple[side] = t == "auto" || isPlainNumber(t);
+            n.width[side] = std::max(0.f, t == "auto" ? 1.f
+                                        : isPlainNumber(t) ? std::stof(t) : LR::parseAbsolute(t));
+        }
+    }
+
+    static contracts::TextWrap::WhiteSpace parseWhiteSpace(const std::string& v) {
+        using WS = contracts::TextWrap::WhiteSpace;
+        if (v=="nowrap")                 return WS::NoWrap;
+        if (v=="pre")                    return WS::Pre;
+        if (v=="pre-wrap")               return WS::PreWrap;
+        if (v=="pre-line")               return WS::PreLine;
+        return WS::Normal;
+    }
+
     static sf::Text::Style parseTextStyle(const std::string& val) {
         sf::Text::Style style = sf::Text::Style::Regular;
         if (val.find("bold")      != std::string::npos)
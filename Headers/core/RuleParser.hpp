@@ -1,6 +1,7 @@
 #pragma once
 #include "../contracts/Types.hpp"
 #include "../utilities/StringUtils.hpp"
+#include "../utilities/Trace.hpp"
 #include <vector>
 #include <string>
 
@@ -21,30 +22,99 @@ namespace core {
 //    • leading/trailing whitespace stripped from property and value
 //    • property name lowercased and camelCase aliases resolved to kebab-case
 //    • lines without ':' are silently skipped
+//    • pseudo-class blocks (":hover { ... }") are left to parseStates()
 // ─────────────────────────────────────────────────────────────────────────────
 struct RuleParser {
 
     static std::vector<contracts::Declaration>
     parse(const std::vector<std::string>& rules) {
+        CSS_TRACE_ZONE("RuleParser::parse");
         std::vector<contracts::Declaration> out;
         out.reserve(rules.size());
 
         for (const auto& rule : rules) {
-            auto colon = rule.find(':');
-            if (colon == std::string::npos) continue;
+            if (isStateBlock(rule)) continue;   // see parseStates()
 
             contracts::Declaration d;
-            d.property = utilities::StringUtils::normaliseProperty(
-                             rule.substr(0, colon));
-            d.value    = utilities::StringUtils::trim(
-                             rule.substr(colon + 1));
-
-            if (!d.property.empty())
+            if (parseDeclaration(rule, d))
                 out.push_back(std::move(d));
         }
 
         return out;
     }
+
+    // Extracts pseudo-class blocks, skipped by parse():
+    //   ":hover { background-color: #89b4fa; border-width: 2px }"
+    // Unknown pseudo-classes are dropped.
+    static std::vector<contracts::StateBlock>
+    parseStates(const std::vector<std::string>& rules) {
+        std::vector<contracts::StateBlock> out;
+
+        for (const auto& rule : rules) {
+            if (!isStateBlock(rule)) continue;
+
+            const std::string s = utilities::StringUtils::trim(rule);
+            const size_t open  = s.find('{');
+            const size_t close = s.rfind('}');
+            if (open == std::string::npos || close == std::string::npos || close < open) {
+                CSS_TRACE_COUNT(ParseFailures);
+                continue;
+            }
+
+            contracts::StateBlock block;
+            block.state = parseState(utilities::StringUtils::trim(s.substr(1, open - 1)));
+            if (block.state == contracts::ElementState::None) {
+                CSS_TRACE_COUNT(ParseFailures);
+                continue;
+            }
+
+            const std::string body = s.substr(open + 1, close - open - 1);
+            size_t start = 0;
+            while (start < body.size()) {
+                size_t semi = body.find(';', start);
+                if (semi == std::string::npos) semi = body.size();
+                const std::string decl = utilities::StringUtils::trim(body.substr(start, semi - start));
+                contracts::Declaration d;
+                if (!decl.empty() && parseDeclaration(decl, d))
+                    block.decls.push_back(std::move(d));
+                start = semi + 1;
+            }
+            out.push_back(std::move(block));
+        }
+
+        return out;
+    }
+
+private:
+    static bool isStateBlock(const std::string& rule) {
+        const auto first = rule.find_first_not_of(" \t\r\n");
+        return first != std::string::npos && rule[first] == ':';
+    }
+
+    static bool parseDeclaration(const std::string& rule, contracts::Declaration& d) {
+        auto colon = rule.find(':');
+        if (colon == std::string::npos) {
+            CSS_TRACE_COUNT(ParseFailures);
+            return false;
+        }
+
+        d.property = utilities::StringUtils::normaliseProperty(
+                         rule.substr(0, colon));
+        d.value    = utilities::StringUtils::trim(
+                         rule.substr(colon + 1));
+
+        return !d.property.empty();
+    }
+
+    static contracts::ElementState parseState(const std::string& name) {
+        using S = contracts::ElementState;
+        const std::string n = utilities::StringUtils::toLower(name);
+        if (n == "hover")    return S::Hover;
+        if (n == "focus")    return S::Focus;
+        if (n == "active")   return S::Active;
+        if (n == "disabled") return S::Disabled;
+        return S::None;
+    }
 };
 
 } // namespace core
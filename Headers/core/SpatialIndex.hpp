@@ -0,0 +1,183 @@
+#pragma once
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace core {
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  SpatialIndex
+//
+//  Uniform grid over axis-aligned boxes, keyed by small dense ids.
+//
+//    • insert/update/remove are incremental — update() is a no-op when the
+//      box still covers the same cells, so re-styling an element that did
+//      not move costs one comparison
+//    • boxes spanning more than kMaxCells cells (full-screen panels) live in
+//      a separate list that every query scans, so they don't bloat the grid
+//    • queries only report candidates whose box overlaps; precise tests
+//      (rotation, paint order) are the caller's job
+// ─────────────────────────────────────────────────────────────────────────────
+
+class SpatialIndex {
+public:
+    using Id = std::uint32_t;
+
+    static constexpr int kMaxCells = 64;
+
+    explicit SpatialIndex(float cellSize = 128.f) : cellSize_(cellSize) {}
+
+    void update(Id id, const sf::FloatRect& box) {
+        if (id >= entries_.size()) entries_.resize(id + 1);
+        Entry& e = entries_[id];
+
+        const CellRange range = cellsOf(box);
+        if (e.present && range == e.range) {
+            e.box = box;
+            return;
+        }
+        if (e.present) unlink(id, e);
+
+        e.box     = box;
+        e.range   = range;
+        e.present = true;
+        link(id, e);
+    }
+
+    void remove(Id id) {
+        if (id >= entries_.size() || !entries_[id].present) return;
+        unlink(id, entries_[id]);
+        entries_[id].present = false;
+    }
+
+    void clear() {
+        entries_.clear();
+        cells_.clear();
+        oversized_.clear();
+        stamps_.clear();
+    }
+
+    // Calls f(id) once for every box containing p.
+    template<typename F>
+    void visitPoint(sf::Vector2f p, F&& f) const {
+        const CellRange c = cellsOf({ p, { 0.f, 0.f } });
+        auto it = cells_.find(key(c.x0, c.y0));
+        if (it != cells_.end())
+            for (Id id : it->second)
+                if (contains(entries_[id].box, p)) f(id);
+        for (Id id : oversized_)
+            if (contains(entries_[id].box, p)) f(id);
+    }
+
+    // Calls f(id) once for every box overlapping r.
+    template<typename F>
+    void visitRect(const sf::FloatRect& r, F&& f) const {
+        if (stamps_.size() < entries_.size()) stamps_.resize(entries_.size(), 0);
+        if (++stamp_ == 0) {
+            std::fill(stamps_.begin(), stamps_.end(), 0);
+            stamp_ = 1;
+        }
+
+        auto visit = [&](Id id) {
+            if (stamps_[id] == stamp_) return;
+            stamps_[id] = stamp_;
+            if (overlaps(entries_[id].box, r)) f(id);
+        };
+
+        const CellRange c = cellsOf(r);
+        const long long span = static_cast<long long>(c.x1 - c.x0 + 1) * (c.y1 - c.y0 + 1);
+        if (span > static_cast<long long>(cells_.size())) {
+            // Query larger than the populated grid — walk the cells instead
+            for (const auto& kv : cells_)
+                for (Id id : kv.second) visit(id);
+        } else {
+            for (int y = c.y0; y <= c.y1; ++y)
+                for (int x = c.x0; x <= c.x1; ++x) {
+                    auto it = cells_.find(key(x, y));
+                    if (it == cells_.end()) continue;
+                    for (Id id : it->second) visit(id);
+                }
+        }
+        for (Id id : oversized_) visit(id);
+    }
+
+    static bool overlaps(const sf::FloatRect& a, const sf::FloatRect& b) {
+        return a.position.x < b.position.x + b.size.x && b.position.x < a.position.x + a.size.x
+            && a.position.y < b.position.y + b.size.y && b.position.y < a.position.y + a.size.y;
+    }
+
+    static bool contains(const sf::FloatRect& r, sf::Vector2f p) {
+        return p.x >= r.position.x && p.x < r.position.x + r.size.x
+            && p.y >= r.position.y && p.y < r.position.y + r.size.y;
+    }
+
+private:
+    struct CellRange {
+        int x0 = 0, y0 = 0, x1 = -1, y1 = -1;
+        bool operator==(const CellRange& o) const {
+            return x0 == o.x0 && y0 == o.y0 && x1 == o.x1 && y1 == o.y1;
+        }
+        [[nodiscard]] long long count() const {
+            return static_cast<long long>(x1 - x0 + 1) * (y1 - y0 + 1);
+        }
+    };
+
+    struct Entry {
+        sf::FloatRect box;
+        CellRange     range;
+        bool          present = false;
+    };
+
+    static std::uint64_t key(int x, int y) {
+        return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(x)) << 32)
+             | static_cast<std::uint32_t>(y);
+    }
+
+    CellRange cellsOf(const sf::FloatRect& r) const {
+        auto cell = [&](float v) { return static_cast<int>(std::floor(v / cellSize_)); };
+        return { cell(r.position.x), cell(r.position.y),
+                 cell(r.position.x + r.size.x), cell(r.position.y + r.size.y) };
+    }
+
+    void link(Id id, const Entry& e) {
+        if (e.range.count() > kMaxCells) {
+            oversized_.push_back(id);
+            return;
+        }
+        for (int y = e.range.y0; y <= e.range.y1; ++y)
+            for (int x = e.range.x0; x <= e.range.x1; ++x)
+                cells_[key(x, y)].push_back(id);
+    }
+
+    void unlink(Id id, const Entry& e) {
+        auto drop = [id](std::vector<Id>& v) {
+            auto it = std::find(v.begin(), v.end(), id);
+            if (it != v.end()) { *it = v.back(); v.pop_back(); }
+        };
+        if (e.range.count() > kMaxCells) {
+            drop(oversized_);
+            return;
+        }
+        for (int y = e.range.y0; y <= e.range.y1; ++y)
+            for (int x = e.range.x0; x <= e.range.x1; ++x) {
+                auto it = cells_.find(key(x, y));
+                if (it == cells_.end()) continue;
+                drop(it->second);
+                if (it->second.empty()) cells_.erase(it);
+            }
+    }
+
+    float                                             cellSize_;
+    std::vector<Entry>                                entries_;
+    std::unordered_map<std::uint64_t, std::vector<Id>> cells_;
+    std::vector<Id>                                   oversized_;
+
+    mutable std::vector<std::uint32_t> stamps_;   // de-duplicates rect queries
+    mutable std::uint32_t              stamp_ = 0;
+};
+
+} // namespace core
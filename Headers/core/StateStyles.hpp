@@ -0,0 +1,177 @@
+#pragma once
+#include "../contracts/Types.hpp"
+#include "../utilities/ColorParser.hpp"
+#include "../utilities/LengthResolver.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace core {
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  StateStyles
+//
+//  Per-element pseudo-class styling compiled ahead of time.
+//
+//  compile() runs once per Style() call, after the base declarations were
+//  applied, and turns every StateBlock into a Delta:
+//    • paint declarations (colors, border-width, opacity) are resolved right
+//      away against the base paint — flipping the state is then a handful
+//      of setter calls with no parsing
+//    • everything else is geometry; a state only needs layout when one of
+//      its geometry declarations differs from the element's declared value
+//
+//  resolve() overlays the deltas of all active states, lowest bit first, so
+//  disabled beats active beats focus beats hover.
+// ─────────────────────────────────────────────────────────────────────────────
+
+struct StateStyles {
+
+    struct Delta {
+        contracts::ElementState              state = contracts::ElementState::None;
+        std::vector<contracts::Declaration>  geometryDecls;   // non-paint declarations
+        std::optional<sf::Color>             fill;
+        std::optional<sf::Color>             outline;
+        std::optional<float>                 outlineThickness;
+        bool                                 geometry = false; // differs from base
+    };
+
+    struct Set {
+        std::vector<contracts::StateBlock> blocks;    // as declared
+        std::vector<Delta>                 deltas;    // sorted by state bit
+        std::uint8_t                       active = 0;
+        contracts::PaintStyle              base;      // paint with no state active
+        contracts::PaintStyle              applied;   // paint currently on the element
+
+        [[nodiscard]] bool empty() const { return blocks.empty(); }
+    };
+
+    static bool isPaintProperty(const std::string& p) {
+        return p == "background-color" || p == "fill" || p == "fill-color" || p == "tint"
+            || p == "color" || p == "border-color" || p == "outline-color"
+            || p == "border-width" || p == "opacity";
+    }
+
+    // Replaces blocks for the states named in `incoming`, keeping the rest.
+    static void merge(Set& set, std::vector<contracts::StateBlock> incoming) {
+        for (auto& block : incoming) {
+            auto it = std::find_if(set.blocks.begin(), set.blocks.end(),
+                [&](const contracts::StateBlock& b) { return b.state == block.state; });
+            if (it != set.blocks.end()) *it = std::move(block);
+            else                        set.blocks.push_back(std::move(block));
+        }
+    }
+
+    static contracts::PaintStyle snapshot(const contracts::IStyleable& el) {
+        return { el.getFillColor(), el.getOutlineColor(), el.getOutlineThickness() };
+    }
+
+    // `resolve(value)` expands var() references in declaration values.
+    template<typename Resolve>
+    static void compile(
+        Set&                                        set,
+        const contracts::IStyleable&                el,
+        const std::vector<contracts::Declaration>&  declared,
+        Resolve&&                                   resolve
+    ) {
+        set.base    = snapshot(el);
+        set.applied = set.base;
+        set.deltas.clear();
+
+        for (const auto& block : set.blocks) {
+            Delta d;
+            d.state = block.state;
+            contracts::PaintStyle p = set.base;
+
+            for (const auto& raw : block.decls) {
+                const contracts::Declaration decl{ raw.property, resolve(raw.value) };
+                if (isPaintProperty(decl.property)) {
+                    applyPaint(p, el.isText(), decl.property, decl.value);
+                } else {
+                    d.geometryDecls.push_back(decl);
+                    if (resolve(declaredValue(declared, decl.property)) != decl.value)
+                        d.geometry = true;
+                }
+            }
+
+            if (p.fill    != set.base.fill)    d.fill    = p.fill;
+            if (p.outline != set.base.outline) d.outline = p.outline;
+            if (p.outlineThickness != set.base.outlineThickness)
+                d.outlineThickness = p.outlineThickness;
+
+            set.deltas.push_back(std::move(d));
+        }
+
+        std::sort(set.deltas.begin(), set.deltas.end(), [](const Delta& a, const Delta& b) {
+            return static_cast<std::uint8_t>(a.state) < static_cast<std::uint8_t>(b.state);
+        });
+    }
+
+    static contracts::PaintStyle resolve(const Set& set, std::uint8_t mask) {
+        contracts::PaintStyle p = set.base;
+        for (const auto& d : set.deltas) {
+            if (!(mask & static_cast<std::uint8_t>(d.state))) continue;
+            if (d.fill)             p.fill             = *d.fill;
+            if (d.outline)          p.outline          = *d.outline;
+            if (d.outlineThickness) p.outlineThickness = *d.outlineThickness;
+        }
+        return p;
+    }
+
+    // True if any state in `mask` changes geometry.
+    static bool hasGeometry(const Set& set, std::uint8_t mask) {
+        for (const auto& d : set.deltas)
+            if ((mask & static_cast<std::uint8_t>(d.state)) && d.geometry) return true;
+        return false;
+    }
+
+    // Geometry declarations of the active states, in precedence order —
+    // appended after the base declarations when the element is re-laid out.
+    static std::vector<contracts::Declaration> geometryOverrides(const Set& set, std::uint8_t mask) {
+        std::vector<contracts::Declaration> out;
+        for (const auto& d : set.deltas)
+            if (mask & static_cast<std::uint8_t>(d.state))
+                out.insert(out.end(), d.geometryDecls.begin(), d.geometryDecls.end());
+        return out;
+    }
+
+    // Writes only the channels that differ from what is already applied.
+    static void applyPaint(Set& set, contracts::IStyleable& el, const contracts::PaintStyle& target) {
+        if (target.fill    != set.applied.fill)    el.setFillColor(target.fill);
+        if (target.outline != set.applied.outline) el.setOutlineColor(target.outline);
+        if (target.outlineThickness != set.applied.outlineThickness)
+            el.setOutlineThickness(target.outlineThickness);
+        set.applied = target;
+    }
+
+private:
+    // Mirrors the paint branches of PropertyDispatcher::pass1
+    static void applyPaint(contracts::PaintStyle& p, bool isText,
+                           const std::string& prop, const std::string& val) {
+        using CP = utilities::ColorParser;
+        if (prop == "background-color" || prop == "fill" || prop == "fill-color" || prop == "tint")
+            p.fill = CP::parse(val);
+        else if (prop == "color")
+            (isText ? p.fill : p.outline) = CP::parse(val);
+        else if (prop == "border-color" || prop == "outline-color")
+            p.outline = CP::parse(val);
+        else if (prop == "border-width")
+            p.outlineThickness = utilities::LengthResolver::parseAbsolute(val);
+        else if (prop == "opacity") {
+            float alpha = utilities::LengthResolver::parseAbsolute(val);
+            if (alpha <= 1.f) alpha *= 255.f;
+            p.fill.a = static_cast<std::uint8_t>(std::clamp(static_cast<int>(alpha), 0, 255));
+        }
+    }
+
+    static std::string declaredValue(const std::vector<contracts::Declaration>& declared,
+                                     const std::string& prop) {
+        for (auto it = declared.rbegin(); it != declared.rend(); ++it)
+            if (it->property == prop) return it->value;
+        return {};
+    }
+};
+
+} // namespace core
@@ -0,0 +1,498 @@
+#pragma once
+#include "../contracts/Types.hpp"
+#include "ContentSize.hpp"
+#include "ContextBuilder.hpp"
+#include "ElementRegistry.hpp"
+#include "FlexLayout.hpp"
+#include "GridLayout.hpp"
+#include "PropertyDispatcher.hpp"
+#include "RuleParser.hpp"
+#include "StateStyles.hpp"
+#include "Variables.hpp"
+#include "../utilities/Trace.hpp"
+#include <algorithm>
+#include <SFML/Graphics/RenderWindow.hpp>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace core {
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  StyleEngine
+//
+//  Runs the pipeline behind every CSS::Style() overload and records its
+//  inputs in the ElementRegistry, so the element can be styled again later
+//  without the caller:
+//
+//    style()    — one Style() call: build context → parse → dispatch →
+//                 content size → flex/grid → record declarations, parent,
+//                 children, states
+//    styleDeferred()
+//               — the same, leaving content size and flex/grid to the
+//                 caller (AsyncLayout, DeferredStyles)
+//    restyle()  — replays an element from its record (merged declarations
+//                 plus the geometry of its active states)
+//    setState() — flips a pseudo-class; paint-only deltas go straight to the
+//                 adapter, geometry deltas restyle the element and the
+//                 container that lays it out
+//    refreshVariable()
+//               — a custom property changed: revisits only the elements
+//                 that reference it, re-applies paint declarations whose
+//                 resolved value changed and restyles only when a geometry
+//                 declaration did
+//    amend()    — a few declarations changed without a Style() call
+//                 (CSS::post): merged into the record, paint applied
+//                 directly, geometry restyles
+//
+//  Declarations are recorded raw ("var(--accent)") and resolved on every
+//  dispatch; the resolved value of each var() declaration is cached in the
+//  record so refreshVariable() can tell what actually changed.
+//
+//  After style() or restyle(), an element whose size changed restyles its
+//  container if that container is sized by its content (width: auto,
+//  fit-content, ...), and so on up while sizes keep changing.
+// ─────────────────────────────────────────────────────────────────────────────
+
+struct StyleEngine {
+
+    using Id = ElementRegistry::Id;
+
+    static void style(
+        contracts::Styleable                        self,
+        const std::vector<std::string>&             rules,
+        std::optional<contracts::Styleable>         parent,
+        contracts::StyleableList*                   children,
+        sf::RenderWindow&                           window
+    ) {
+        run(std::move(self), rules, std::move(parent), children, window, true);
+    }
+
+    // style() without content sizing, laying out the children and
+    // resizing a content-sized container: returns the context that would
+    // do it, for AsyncLayout / DeferredStyles to run later and finish with
+    // resized()
+    static contracts::StyleContext styleDeferred(
+        contracts::Styleable                        self,
+        const std::vector<std::string>&             rules,
+        std::optional<contracts::Styleable>         parent,
+        contracts::StyleableList*                   children,
+        sf::RenderWindow&                           window
+    ) {
+        return run(std::move(self), rules, std::move(parent), children, window, false);
+    }
+
+    static void restyle(Id id, sf::RenderWindow& window) {
+        auto& rec = ElementRegistry::at(id);
+        contracts::Styleable self = rec.handle;
+        const sf::Vector2f before = self->getSize();
+
+        std::vector<contracts::Declaration> decls = resolve(id, rec.declared);
+        if (rec.states.active) {
+            StateStyles::applyPaint(rec.states, *self, rec.states.base);
+            auto extra = StateStyles::geometryOverrides(rec.states, rec.states.active);
+            decls.insert(decls.end(), extra.begin(), extra.end());
+        }
+
+        std::optional<contracts::Styleable> parent;
+        if (rec.parent.valid()) parent = rec.parent;
+
+        auto ctx = ContextBuilder::build(self, parent, window);
+        PropertyDispatcher::apply(ctx, decls);
+        stacking(id, decls);
+        if (rec.hasChildren) {
+            rec.contentSized = ctx.content.any();
+            contracts::StyleableList children = rec.children;
+            ContentSize::apply(ctx, children);
+            layout(ctx, children);
+            ElementRegistry::track(children);
+        }
+        ElementRegistry::track(self);
+        resized(id, before, window);
+
+        auto& after = ElementRegistry::at(id);
+        if (after.states.empty()) return;
+        StateStyles::compile(after.states, *self, after.declared, Resolver{ id });
+        if (after.states.active)
+            StateStyles::applyPaint(after.states, *self,
+                                    StateStyles::resolve(after.states, after.states.active));
+    }
+
+    static void setState(
+        const void*              native,
+        contracts::ElementState  state,
+        bool                     on,
+        sf::RenderWindow&        window
+    ) {
+        const Id id = ElementRegistry::find(native);
+        if (id == ElementRegistry::kInvalid) return;
+
+        auto& rec = ElementRegistry::at(id);
+        const std::uint8_t bit    = static_cast<std::uint8_t>(state);
+        const std::uint8_t before = rec.states.active;
+        const std::uint8_t after  = static_cast<std::uint8_t>(on ? (before | bit) : (before & ~bit));
+        if (before == after) return;
+
+        rec.states.active = after;
+        if (rec.states.empty()) return;
+
+        if (StateStyles::hasGeometry(rec.states, bit)) {
+            const Id container = rec.container;
+            restyle(id, window);
+            if (container != ElementRegistry::kInvalid) restyle(container, window);
+            return;
+        }
+
+        StateStyles::applyPaint(rec.states, *rec.handle, StateStyles::resolve(rec.states, after));
+    }
+
+    // Moves :hover to the topmost element under `point`.
+    static void hover(sf::Vector2f point, sf::RenderWindow& window) {
+        contracts::Styleable hit = ElementRegistry::hitTest(point);
+        const void* now = hit.valid() ? hit->native() : nullptr;
+
+        const void*& hovered = hoveredNative();
+        if (now == hovered) return;
+
+        if (hovered) setState(hovered, contracts::ElementState::Hover, false, window);
+        if (now)     setState(now,     contracts::ElementState::Hover, true,  window);
+        hovered = now;
+    }
+
+    // The element is going away; a later one at its address isn't hovered
+    static void forget(const void* native) {
+        const void*& hovered = hoveredNative();
+        if (hovered == native) hovered = nullptr;
+    }
+
+    // Root definition changed (CSS::setVar) or a scoped one was redefined.
+    static void refreshVariable(const std::string& name, sf::RenderWindow& window) {
+        CSS_TRACE_ZONE("StyleEngine::refreshVariable");
+        for (Id id : Variables::dependents(name)) update(id, window);
+    }
+
+    // Declarations changed outside a Style() call (CSS::post), merged into
+    // the record: paint-only changes go straight to the adapter, anything
+    // else restyles the element and the container that lays it out. An
+    // element never styled is styled with just these.
+    static void amend(contracts::Styleable self, std::vector<contracts::Declaration> decls,
+                      sf::RenderWindow& window) {
+        const Id id = ElementRegistry::find(self->native());
+        if (id == ElementRegistry::kInvalid) {
+            std::vector<std::string> rules;
+            rules.reserve(decls.size());
+            for (const auto& d : decls) rules.push_back(d.property + ": " + d.value);
+            style(std::move(self), rules, std::nullopt, nullptr, window);
+            return;
+        }
+
+        const auto changed = define(id, decls);
+        auto& rec = ElementRegistry::at(id);
+        ElementRegistry::declare(rec, decls);
+        relink(id);
+
+        const bool geometry = std::any_of(decls.begin(), decls.end(),
+            [](const contracts::Declaration& d) { return !StateStyles::isPaintProperty(d.property); });
+        if (geometry) {
+            const Id container = rec.container;
+            restyle(id, window);
+            if (container != ElementRegistry::kInvalid) restyle(container, window);
+        } else if (!decls.empty()) {
+            if (rec.states.active) StateStyles::applyPaint(rec.states, *self, rec.states.base);
+            std::optional<contracts::Styleable> parent;
+            if (rec.parent.valid()) parent = rec.parent;
+            auto ctx = ContextBuilder::build(self, parent, window);
+            PropertyDispatcher::apply(ctx, resolve(id, decls));
+
+            auto& after = ElementRegistry::at(id);
+            if (!after.states.empty()) {
+                StateStyles::compile(after.states, *self, after.declared, Resolver{ id });
+                if (after.states.active)
+                    StateStyles::applyPaint(after.states, *self,
+                                            StateStyles::resolve(after.states, after.states.active));
+            }
+        }
+
+        for (const auto& name : changed) refreshVariable(name, window);
+    }
+
+    static void refreshImage(const void* native, sf::RenderWindow& window) {
+        const Id id = ElementRegistry::find(native);
+        if (id == ElementRegistry::kInvalid) return;
+        auto& rec = ElementRegistry::at(id);
+        if (!rec.handle.valid()) return;
+        contracts::Styleable self = rec.handle;
+
+        std::vector<contracts::Declaration> decls;
+        for (auto& d : resolve(id, rec.declared)) {
+            if (PropertyDispatcher::isImageSource(d) || (self->isSprite() && sizedByImage(d.property)))
+                decls.push_back(std::move(d));
+        }
+        if (decls.empty()) return;
+
+        const sf::Vector2f before = self->getSize();
+        std::optional<contracts::Styleable> parent;
+        if (rec.parent.valid()) parent = rec.parent;
+        auto ctx = ContextBuilder::build(self, parent, window);
+        PropertyDispatcher::apply(ctx, decls);
+        ElementRegistry::track(self);
+
+        // Natural-size sprites can change size, which moves their siblings
+        const Id container = ElementRegistry::at(id).container;
+        if (self->getSize() != before && container != ElementRegistry::kInvalid)
+            restyle(container, window);
+    }
+
+    // A container sized by its content follows the element's new size, and
+    // so on up while sizes keep changing
+    static void resized(Id id, sf::Vector2f before, sf::RenderWindow& window) {
+        const auto& rec = ElementRegistry::at(id);
+        if (rec.container == ElementRegistry::kInvalid || rec.handle->getSize() == before) return;
+        if (ElementRegistry::at(rec.container).contentSized) restyle(rec.container, window);
+    }
+
+private:
+    static contracts::StyleContext run(
+        contracts::Styleable                        self,
+        const std::vector<std::string>&             rules,
+        std::optional<contracts::Styleable>         parent,
+        contracts::StyleableList*                   children,
+        sf::RenderWindow&                           window,
+        bool                                        layoutNow
+    ) {
+        // Start from base paint so the new snapshot doesn't capture a state
+        const Id existing = ElementRegistry::find(self->native());
+        if (existing != ElementRegistry::kInvalid) {
+            auto& st = ElementRegistry::at(existing).states;
+            if (st.active) StateStyles::applyPaint(st, *self, st.base);
+        }
+
+        // Registered up front: var() lookups walk the record's parent chain
+        const sf::Vector2f before = self->getSize();
+        const Id id = ElementRegistry::track(self);
+        ElementRegistry::at(id).parent = parent.value_or(contracts::Styleable{});
+
+        auto raw     = RuleParser::parse(rules);
+        auto changed = define(id, raw);
+        auto decls   = resolve(id, raw);
+
+        auto ctx = ContextBuilder::build(self, parent, window);
+        PropertyDispatcher::apply(ctx, decls);
+        if (children && layoutNow) {
+            ContentSize::apply(ctx, *children);
+            layout(ctx, *children);
+        }
+
+        ElementRegistry::track(self);
+        if (children) {
+            for (const auto& child : *children) {
+                const Id cid = ElementRegistry::track(child);
+                if (cid != ElementRegistry::kInvalid)
+                    ElementRegistry::at(cid).container = id;
+            }
+        }
+
+        auto& rec = ElementRegistry::at(id);
+        ElementRegistry::declare(rec, raw);
+        if (children) {
+            rec.children     = *children;
+            rec.hasChildren  = true;
+            rec.contentSized = ctx.content.any();
+        }
+        stacking(id, decls);
+        if (children)
+            for (const auto& child : *children) ElementRegistry::stack(ElementRegistry::find(child->native()));
+
+        auto blocks = RuleParser::parseStates(rules);
+        if (!blocks.empty()) StateStyles::merge(rec.states, std::move(blocks));
+        relink(id);
+
+        if (!rec.states.empty()) {
+            StateStyles::compile(rec.states, *self, rec.declared, Resolver{ id });
+            if (StateStyles::hasGeometry(rec.states, rec.states.active))
+                restyle(id, window);
+            else if (rec.states.active)
+                StateStyles::applyPaint(rec.states, *self,
+                                        StateStyles::resolve(rec.states, rec.states.active));
+        }
+
+        // Scoped definitions that changed reach elements styled earlier
+        for (const auto& name : changed) refreshVariable(name, window);
+        if (layoutNow) resized(id, before, window);
+        return ctx;
+    }
+
+    static bool sizedByImage(const std::string& p) {
+        return p == "width" || p == "height" || p == "size"
+            || p == "min-width" || p == "max-width" || p == "min-height" || p == "max-height"
+            || p == "left" || p == "x" || p == "right" || p == "top" || p == "y" || p == "bottom"
+            || p == "position" || p == "origin";
+    }
+
+    static void layout(const contracts::StyleContext& ctx, contracts::StyleableList& children) {
+        if (ctx.grid.enabled) GridLayout::apply(ctx, children);
+        else                  FlexLayout::apply(ctx, children);
+    }
+
+    // ── Stacking ────────────────────────────────────────────────────────────
+
+    // Reads z-index and overflow from the dispatched declarations. Gaining
+    // or losing a z-index or a clip changes what the element's descendants
+    // belong to; changing a z-index value only moves the element (and its
+    // contents).
+    static void stacking(Id id, const std::vector<contracts::Declaration>& decls) {
+        auto& rec = ElementRegistry::at(id);
+        std::optional<int> z = rec.zIndex;
+        bool clips = rec.clips;
+        for (const auto& d : decls) {
+            if (d.property == "z-index")  z     = parseZIndex(d.value);
+            if (d.property == "overflow") clips = (d.value != "visible");
+        }
+
+        const bool flipped = z.has_value() != rec.zIndex.has_value() || clips != rec.clips;
+        rec.zIndex = z;
+        rec.clips  = clips;
+        if (flipped) ElementRegistry::restack();
+        else         ElementRegistry::stack(id);
+    }
+
+    static std::optional<int> parseZIndex(const std::string& v) {
+        if (v == "auto") return std::nullopt;
+        try {
+            return std::stoi(v);
+        } catch (...) {
+            CSS_TRACE_COUNT(ParseFailures);
+            return std::nullopt;
+        }
+    }
+
+    // ── Custom properties ───────────────────────────────────────────────────
+
+    // Moves "--name: value" declarations into the record's scope and returns
+    // the names whose value changed.
+    static std::vector<std::string> define(Id id, std::vector<contracts::Declaration>& decls) {
+        auto& vars = ElementRegistry::at(id).vars;
+        std::vector<std::string> changed;
+        decls.erase(std::remove_if(decls.begin(), decls.end(),
+            [&](const contracts::Declaration& d) {
+                if (!Variables::isDefinition(d.property)) return false;
+                auto it = vars.find(d.property);
+                if (it == vars.end() || it->second != d.value) {
+                    vars[d.property] = d.value;
+                    changed.push_back(d.property);
+                }
+                return true;
+            }), decls.end());
+        return changed;
+    }
+
+    // Nearest scoped definition (self, then parent, then container chain),
+    // falling back to the root definition.
+    static std::optional<std::string> lookup(Id id, const std::string& name) {
+        for (int hop = 0; id != ElementRegistry::kInvalid && hop < 64; ++hop) {
+            const auto& rec = ElementRegistry::at(id);
+            auto it = rec.vars.find(name);
+            if (it != rec.vars.end()) return it->second;
+            id = ElementRegistry::ancestor(id);
+        }
+        return Variables::root(name);
+    }
+
+    // Expands var() references as seen from one element.
+    struct Resolver {
+        Id id;
+        std::string operator()(const std::string& value) const {
+            std::vector<std::string> used;
+            return Variables::substitute(value,
+                [this](const std::string& n) { return lookup(id, n); }, used);
+        }
+    };
+
+    // Resolved copies for dispatch; caches the value of every var() declaration.
+    static std::vector<contracts::Declaration> resolve(Id id, const std::vector<contracts::Declaration>& decls) {
+        auto& cache = ElementRegistry::at(id).varValues;
+        auto  value = Resolver{ id };
+
+        std::vector<contracts::Declaration> out;
+        out.reserve(decls.size());
+        for (const auto& d : decls) {
+            if (!Variables::hasReference(d.value)) {
+                out.push_back(d);
+                continue;
+            }
+            std::string v = value(d.value);
+            cache[d.property] = v;
+            out.push_back({ d.property, std::move(v) });
+        }
+        return out;
+    }
+
+    // Re-registers the element under every variable it references.
+    static void relink(Id id) {
+        auto& rec = ElementRegistry::at(id);
+        std::vector<std::string> names;
+        auto collect = [&](const std::vector<contracts::Declaration>& decls) {
+            for (const auto& d : decls)
+                if (Variables::hasReference(d.value))
+                    Variables::substitute(d.value,
+                        [id](const std::string& n) { return lookup(id, n); }, names);
+        };
+        collect(rec.declared);
+        for (const auto& block : rec.states.blocks) collect(block.decls);
+
+        Variables::unlink(id, rec.varRefs);
+        Variables::link(id, names);
+        rec.varRefs = std::move(names);
+    }
+
+    static void update(Id id, sf::RenderWindow& window) {
+        auto& rec = ElementRegistry::at(id);
+        if (!rec.handle.valid()) return;
+        contracts::Styleable self = rec.handle;
+        auto value = Resolver{ id };
+
+        std::vector<contracts::Declaration> paint;
+        bool geometry = false;
+        for (const auto& d : rec.declared) {
+            if (!Variables::hasReference(d.value)) continue;
+            std::string v = value(d.value);
+            auto& cached = rec.varValues[d.property];
+            if (cached == v) continue;
+            cached = v;
+            if (StateStyles::isPaintProperty(d.property)) paint.push_back({ d.property, std::move(v) });
+            else                                           geometry = true;
+        }
+
+        if (geometry) {
+            const Id container = rec.container;
+            restyle(id, window);
+            if (container != ElementRegistry::kInvalid) restyle(container, window);
+            return;
+        }
+        if (paint.empty() && rec.states.empty()) return;
+
+        if (rec.states.active) StateStyles::applyPaint(rec.states, *self, rec.states.base);
+        if (!paint.empty()) {
+            std::optional<contracts::Styleable> parent;
+            if (rec.parent.valid()) parent = rec.parent;
+            auto ctx = ContextBuilder::build(self, parent, window);
+            PropertyDispatcher::apply(ctx, paint);
+        }
+        if (rec.states.empty()) return;
+
+        // State blocks may reference the variable as well
+        StateStyles::compile(rec.states, *self, rec.declared, value);
+        if (StateStyles::hasGeometry(rec.states, rec.states.active))
+            restyle(id, window);
+        else if (rec.states.active)
+            StateStyles::applyPaint(rec.states, *self,
+                                    StateStyles::resolve(rec.states, rec.states.active));
+    }
+
+    static const void*& hoveredNative() {
+        static const void* hovered = nullptr;
+        return hovered;
+    }
+};
+
+} // namespace core
@@ -0,0 +1,153 @@
+#pragma once
+#include "../utilities/StringUtils.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace core {
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  Variables
+//
+//  CSS custom properties: "--accent: #89b4fa" and "var(--accent, white)".
+//
+//  Two kinds of definition:
+//    • root — CSS::setVar("--accent", "#89b4fa"), visible everywhere
+//    • scoped — "--accent: ..." inside an element's Style() rules, visible to
+//      that element and to everything styled with it as (transitive) parent;
+//      the scoped values live in the element's registry record
+//
+//  Dependency graph: variable name → ids of elements whose declarations (or
+//  state blocks) reference it. When a definition changes only those
+//  elements are revisited, and among them only declarations whose resolved
+//  value actually changed are re-applied.
+//
+//  substitute() expands var() references recursively (fallbacks may
+//  contain var() too); cycles stop after kMaxDepth expansions.
+// ─────────────────────────────────────────────────────────────────────────────
+
+struct Variables {
+
+    using Id = std::uint32_t;
+    static constexpr int kMaxDepth = 16;
+
+    static bool isDefinition(const std::string& property) {
+        return property.size() > 2 && property[0] == '-' && property[1] == '-';
+    }
+
+    static bool hasReference(const std::string& value) {
+        return value.find("var(") != std::string::npos;
+    }
+
+    // ── Root definitions ──────────────────────────────────────────────────
+    // Returns false if the value did not change.
+    static bool setRoot(const std::string& name, const std::string& value) {
+        auto& roots = storage().roots;
+        auto it = roots.find(name);
+        if (it != roots.end() && it->second == value) return false;
+        roots[name] = value;
+        return true;
+    }
+
+    [[nodiscard]] static std::optional<std::string> root(const std::string& name) {
+        auto& roots = storage().roots;
+        auto it = roots.find(name);
+        if (it == roots.end()) return std::nullopt;
+        return it->second;
+    }
+
+    // ── Dependency graph ──────────────────────────────────────────────────
+    static void link(Id id, const std::vector<std::string>& names) {
+        for (const auto& n : names) storage().dependents[n].insert(id);
+    }
+
+    static void unlink(Id id, const std::vector<std::string>& names) {
+        auto& deps = storage().dependents;
+        for (const auto& n : names) {
+            auto it = deps.find(n);
+            if (it == deps.end()) continue;
+            it->second.erase(id);
+            if (it->second.empty()) deps.erase(it);
+        }
+    }
+
+    static void clearLinks() { storage().dependents.clear(); }
+
+    [[nodiscard]] static std::vector<Id> dependents(const std::string& name) {
+        auto& deps = storage().dependents;
+        auto it = deps.find(name);
+        if (it == deps.end()) return {};
+        return { it->second.begin(), it->second.end() };
+    }
+
+    // ── Substitution ──────────────────────────────────────────────────────
+    // `lookup(name)` returns std::optional<std::string>. Every name looked
+    // up is appended to `used` (deduplicated) for dependency tracking.
+    template<typename Lookup>
+    static std::string substitute(
+        const std::string&        value,
+        Lookup&&                  lookup,
+        std::vector<std::string>& used,
+        int                       depth = 0
+    ) {
+        if (depth >= kMaxDepth || !hasReference(value)) return value;
+
+        std::string out;
+        out.reserve(value.size());
+        size_t pos = 0;
+
+        while (pos < value.size()) {
+            const size_t start = value.find("var(", pos);
+            if (start == std::string::npos) {
+                out.append(value, pos, std::string::npos);
+                break;
+            }
+            out.append(value, pos, start - pos);
+
+            // Find the matching ')' and the first top-level ','
+            const size_t open = start + 3;
+            size_t close = std::string::npos, comma = std::string::npos;
+            int nesting = 0;
+            for (size_t i = open; i < value.size(); ++i) {
+                const char c = value[i];
+                if (c == '(') ++nesting;
+                else if (c == ')' && --nesting == 0) { close = i; break; }
+                else if (c == ',' && nesting == 1 && comma == std::string::npos) comma = i;
+            }
+            if (close == std::string::npos) {     // unbalanced — keep verbatim
+                out.append(value, start, std::string::npos);
+                break;
+            }
+
+            const size_t nameEnd = comma != std::string::npos ? comma : close;
+            const std::string name = utilities::StringUtils::trim(value.substr(open + 1, nameEnd - open - 1));
+            if (std::find(used.begin(), used.end(), name) == used.end()) used.push_back(name);
+
+            if (auto v = lookup(name))
+                out += substitute(*v, lookup, used, depth + 1);
+            else if (comma != std::string::npos)
+                out += substitute(utilities::StringUtils::trim(value.substr(comma + 1, close - comma - 1)),
+                                  lookup, used, depth + 1);
+
+            pos = close + 1;
+        }
+        return out;
+    }
+
+private:
+    struct Storage {
+        std::unordered_map<std::string, std::string>             roots;
+        std::unordered_map<std::string, std::unordered_set<Id>>  dependents;
+    };
+
+    static Storage& storage() {
+        static Storage s;
+        return s;
+    }
+};
+
+} // namespace core
@@ -0,0 +1,295 @@
+#pragma once
+#include "StringUtils.hpp"
+#include "Trace.hpp"
+#include <SFML/System/Vector2.hpp>
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace utilities {
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  CalcExpression
+//
+//  calc(), min(), max() and clamp() compiled to postfix bytecode:
+//
+//    "calc(100% - 48px)"          → push 100%, push 48px, sub
+//    "clamp(200px, 50vw, 600px)"  → push 200px, push 50vw, push 600px,
+//                                   min 2, max 2
+//
+//  Operands keep their unit; evaluate() turns them into pixels against the
+//  reference and viewport it is given, so one compiled expression serves
+//  every relayout. Nesting (calc inside min, parentheses) and unary minus
+//  are supported; em/rem/pt/dp count as px, as in LengthResolver.
+//
+//  compiled() keeps the bytecode of every expression text seen, per thread,
+//  so a value is parsed the first time it is resolved and evaluated from
+//  then on. The table is dropped wholesale past kCapacity entries.
+//
+//  Expressions that don't parse, divide by a length or nest deeper than
+//  kMaxDepth compile to nothing and evaluate to 0.
+// ─────────────────────────────────────────────────────────────────────────────
+
+class CalcExpression {
+public:
+    static constexpr std::size_t kCapacity = 1024;
+    static constexpr std::size_t kMaxDepth = 16;
+
+    enum class Unit : std::uint8_t { Number, Px, Percent, Vw, Vh };
+    enum class Op   : std::uint8_t { Push, Add, Sub, Mul, Div, Negate, Min, Max };
+
+    struct Instr {
+        Op            op;
+        Unit          unit;     // Push only
+        std::uint8_t  count;    // Min / Max: operands taken
+        float         value;    // Push only
+    };
+
+    // "calc(", "min(", "max(" or "clamp(" first, any case
+    static bool isExpression(const std::string& s) {
+        std::size_t i = s.find_first_not_of(" \t\r\n");
+        if (i == std::string::npos) return false;
+        for (const char* name : { "calc(", "min(", "max(", "clamp(" }) {
+            std::size_t k = 0;
+            while (name[k] && i + k < s.size()
+                   && std::tolower(static_cast<unsigned char>(s[i + k])) == name[k]) ++k;
+            if (!name[k]) return true;
+        }
+        return false;
+    }
+
+    static CalcExpression compile(const std::string& s) {
+        CSS_TRACE_ZONE("CalcExpression::compile");
+        CalcExpression e;
+        Compiler c{ StringUtils::toLower(s), 0, e.code_, 0, true };
+        c.sum();
+        c.skipSpace();
+        if (!c.ok || c.pos != c.src.size() || e.code_.empty()) {
+            CSS_TRACE_COUNT(ParseFailures);
+            e.code_.clear();
+        }
+        e.code_.shrink_to_fit();
+        return e;
+    }
+
+    // Bytecode for `s`, compiled on first use
+    static const CalcExpression& compiled(const std::string& s) {
+        thread_local std::unordered_map<std::string, CalcExpression> table;
+        const auto it = table.find(s);
+        if (it != table.end()) return it->second;
+        if (table.size() >= kCapacity) table.clear();
+        return table.emplace(s, compile(s)).first->second;
+    }
+
+    [[nodiscard]] bool valid() const { return !code_.empty(); }
+    [[nodiscard]] const std::vector<Instr>& code() const { return code_; }
+
+    float evaluate(float reference, sf::Vector2f windowSize = {0.f, 0.f}) const {
+        float stack[kMaxDepth];
+        std::size_t top = 0;
+        for (const Instr& in : code_) {
+            switch (in.op) {
+                case Op::Push:
+                    stack[top++] = in.value * scale(in.unit, reference, windowSize);
+                    break;
+                case Op::Negate:
+                    stack[top - 1] = -stack[top - 1];
+                    break;
+                case Op::Add: --top; stack[top - 1] += stack[top]; break;
+                case Op::Sub: --top; stack[top - 1] -= stack[top]; break;
+                case Op::Mul: --top; stack[top - 1] *= stack[top]; break;
+                case Op::Div:
+                    --top;
+                    stack[top - 1] = stack[top] != 0.f ? stack[top - 1] / stack[top] : 0.f;
+                    break;
+                case Op::Min:
+                case Op::Max: {
+                    top -= in.count - 1;
+                    float& r = stack[top - 1];
+                    for (std::size_t i = 0; i + 1 < in.count; ++i)
+                        r = in.op == Op::Min ? std::min(r, stack[top + i]) : std::max(r, stack[top + i]);
+                    break;
+                }
+            }
+        }
+        return top == 1 ? stack[0] : 0.f;
+    }
+
+private:
+    std::vector<Instr> code_;
+
+    enum class Function { None, Calc, Min, Max, Clamp };
+
+    static Function function(const std::string& name) {
+        const std::string n = StringUtils::toLower(name);
+        if (n == "calc")  return Function::Calc;
+        if (n == "min")   return Function::Min;
+        if (n == "max")   return Function::Max;
+        if (n == "clamp") return Function::Clamp;
+        return Function::None;
+    }
+
+    static float scale(Unit u, float reference, sf::Vector2f windowSize) {
+        switch (u) {
+            case Unit::Percent: return reference / 100.f;
+            case Unit::Vw:      return windowSize.x / 100.f;
+            case Unit::Vh:      return windowSize.y / 100.f;
+            default:            return 1.f;
+        }
+    }
+
+    // Recursive descent over the lowercased text, emitting postfix as it
+    // goes; `depth` tracks the evaluation stack the code will need. Each
+    // production returns whether its value is a plain number, which is all
+    // the type checking * and / need.
+    struct Compiler {
+        std::string          src;
+        std::size_t          pos;
+        std::vector<Instr>&  out;
+        std::size_t          depth;
+        bool                 ok;
+
+        void skipSpace() {
+            while (pos < src.size() && std::isspace(static_cast<unsigned char>(src[pos]))) ++pos;
+        }
+
+        bool eat(char c) {
+            skipSpace();
+            if (pos < src.size() && src[pos] == c) { ++pos; return true; }
+            return false;
+        }
+
+        void emit(Op op, std::uint8_t count = 0) {
+            out.push_back({ op, Unit::Number, count, 0.f });
+            if (op != Op::Negate) depth -= op == Op::Min || op == Op::Max ? count - 1u : 1u;
+        }
+
+        void push(float value, Unit unit) {
+            out.push_back({ Op::Push, unit, 0, value });
+            if (++depth > kMaxDepth) ok = false;
+        }
+
+        // product (('+' | '-') product)*
+        bool sum() {
+            bool number = product();
+            while (ok) {
+                if (eat('+'))      { number = product() && number; emit(Op::Add); }
+                else if (eat('-')) { number = product() && number; emit(Op::Sub); }
+                else break;
+            }
+            return number;
+        }
+
+        // unary (('*' | '/') unary)*
+        bool product() {
+            bool number = unary();
+            while (ok) {
+                if (eat('*')) {
+                    const bool rhs = unary();
+                    if (!number && !rhs) ok = false;
+                    number = number && rhs;
+                    emit(Op::Mul);
+                } else if (eat('/')) {
+                    if (!unary()) ok = false;
+                    emit(Op::Div);
+                } else break;
+            }
+            return number;
+        }
+
+        // '-' unary | primary
+        bool unary() {
+            skipSpace();
+            if (pos < src.size() && src[pos] == '-' && !startsNumber(pos + 1)) {
+                ++pos;
+                const bool number = unary();
+                emit(Op::Negate);
+                return number;
+            }
+            return primary();
+        }
+
+        // number [unit] | '(' sum ')' | calc(...) | min(...) | max(...) | clamp(...)
+        bool primary() {
+            skipSpace();
+            if (!ok || pos >= src.size()) { ok = false; return false; }
+            if (startsNumber(pos)) return operand();
+            if (eat('(')) {
+                const bool number = sum();
+                if (!eat(')')) ok = false;
+                return number;
+            }
+
+            const std::size_t start = pos;
+            while (pos < src.size() && std::isalpha(static_cast<unsigned char>(src[pos]))) ++pos;
+            const Function f = function(src.substr(start, pos - start));
+            if (f == Function::None || !eat('(')) { ok = false; return false; }
+
+            std::size_t count = 0;
+            bool number = true;
+            do {
+                number = sum() && number;
+                ++count;
+            } while (ok && eat(','));
+            if (!eat(')')) ok = false;
+
+            switch (f) {
+                case Function::Calc:
+                    if (count != 1) ok = false;
+                    break;
+                case Function::Min:
+                case Function::Max:
+                    if (count > 255) { ok = false; break; }
+                    if (count > 1) emit(f == Function::Min ? Op::Min : Op::Max, static_cast<std::uint8_t>(count));
+                    break;
+                case Function::Clamp:
+                    // clamp(lo, v, hi) = max(lo, min(v, hi))
+                    if (count != 3) { ok = false; break; }
+                    emit(Op::Min, 2);
+                    emit(Op::Max, 2);
+                    break;
+                case Function::None:
+                    break;
+            }
+            return number;
+        }
+
+        bool startsNumber(std::size_t i) const {
+            if (i < src.size() && (src[i] == '+' || src[i] == '-')) ++i;
+            if (i < src.size() && src[i] == '.') ++i;
+            return i < src.size() && std::isdigit(static_cast<unsigned char>(src[i]));
+        }
+
+        bool operand() {
+            const std::size_t start = pos;
+            if (src[pos] == '+' || src[pos] == '-') ++pos;
+            while (pos < src.size() && (std::isdigit(static_cast<unsigned char>(src[pos])) || src[pos] == '.')) ++pos;
+            float value = 0.f;
+            try {
+                value = std::stof(src.substr(start, pos - start));
+            } catch (...) {
+                ok = false;
+                return false;
+            }
+
+            const std::size_t u = pos;
+            if (pos < src.size() && src[pos] == '%') ++pos;
+            else while (pos < src.size() && std::isalpha(static_cast<unsigned char>(src[pos]))) ++pos;
+            const std::string unit = src.substr(u, pos - u);
+
+            if (unit.empty())                   push(value, Unit::Number);
+            else if (unit == "%")               push(value, Unit::Percent);
+            else if (unit == "vw")              push(value, Unit::Vw);
+            else if (unit == "vh")              push(value, Unit::Vh);
+            else if (unit == "px" || unit == "em" || unit == "rem"
+                  || unit == "pt" || unit == "dp") push(value, Unit::Px);
+            else                                ok = false;
+            return unit.empty();
+        }
+    };
+};
+
+} // namespace utilities
@@ -1,5 +1,6 @@
 #pragma once
 #include "StringUtils.hpp"
+#include "Trace.hpp"
 #include <SFML/Graphics/Color.hpp>
 #include <unordered_map>
 #include <string>
@@ -63,6 +64,7 @@ private:
                 );
             } catch (...) {}
         }
+        CSS_TRACE_COUNT(ParseFailures);
         return sf::Color::White; // fallback
     }
 
@@ -129,7 +131,9 @@ private:
         };
 
         auto it = table.find(name);
-        return (it != table.end()) ? it->second : sf::Color::White;
+        if (it != table.end()) return it->second;
+        CSS_TRACE_COUNT(ParseFailures);
+        return sf::Color::White;
     }
 };
 
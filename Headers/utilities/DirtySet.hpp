@@ -0,0 +1,45 @@
+#pragma once
+#include <cstdint>
+#include <unordered_map>
+
+namespace utilities {
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  DirtySet
+//
+//  Elements whose drawn result may have changed since the last frame, keyed
+//  by native SFML object, marked by the adapter setters:
+//
+//    Geometry — position, origin, scale, rotation, size. core::Damage drops
+//               the mark again if the element ends up where it was drawn.
+//    Paint    — colors, textures, text, background layers. Always damage.
+//
+//  Setters that take a value compare it with the current one first, so
+//  re-applying an unchanged style marks nothing.
+// ─────────────────────────────────────────────────────────────────────────────
+
+struct DirtySet {
+    enum Kind : std::uint8_t { Geometry = 1, Paint = 2 };
+
+    static void mark(const void* native, Kind kind) { marks()[native] |= kind; }
+
+    template<typename T>
+    static void mark(const void* native, Kind kind, const T& before, const T& after) {
+        if (!(before == after)) mark(native, kind);
+    }
+
+    [[nodiscard]] static bool empty() { return marks().empty(); }
+
+    [[nodiscard]] static const std::unordered_map<const void*, std::uint8_t>& all() { return marks(); }
+
+    static void erase(const void* native) { marks().erase(native); }
+    static void clear() { marks().clear(); }
+
+private:
+    static std::unordered_map<const void*, std::uint8_t>& marks() {
+        static std::unordered_map<const void*, std::uint8_t> m;
+        return m;
+    }
+};
+
+} // namespace utilities
@@ -0,0 +1,159 @@
+#pragma once
+#include "../contracts/Gradient.hpp"
+#include "ColorParser.hpp"
+#include "LengthResolver.hpp"
+#include "StringUtils.hpp"
+#include "Trace.hpp"
+#include <cctype>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace utilities {
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  GradientParser
+//
+//  Parses gradient functions into contracts::Gradient:
+//
+//    linear-gradient(red, blue)                    → top to bottom
+//    linear-gradient(90deg, red, blue 40%, #fff)   → deg rad grad turn
+//    linear-gradient(to top right, red, blue)      → side or corner
+//    radial-gradient(red, blue)                    → ellipse, farthest-corner
+//    radial-gradient(circle closest-side at 30% 40%, red 10%, blue)
+//    radial-gradient(at left top, red, 20px, blue) → a bare length is skipped
+//
+//  Stops take an optional % or px position ("red 10% 30%" is two stops).
+//  Returns Kind::None for anything else — callers treat that as "not a
+//  gradient".
+// ─────────────────────────────────────────────────────────────────────────────
+
+struct GradientParser {
+
+    [[nodiscard]] static bool isGradient(const std::string& val) {
+        const std::string v = StringUtils::toLower(StringUtils::trim(val));
+        return v.rfind("linear-gradient(", 0) == 0 || v.rfind("radial-gradient(", 0) == 0;
+    }
+
+    static contracts::Gradient parse(const std::string& val) {
+        using G = contracts::Gradient;
+        G g;
+        const std::string v = StringUtils::trim(val);
+        const std::string lower = StringUtils::toLower(v);
+        const size_t open = v.find('(');
+        if (!isGradient(v) || v.back() != ')') return g;
+
+        auto args = StringUtils::splitTopLevel(v.substr(open + 1, v.size() - open - 2), ',');
+        if (args.empty()) return g;
+
+        const bool linear = lower[0] == 'l';
+        g.kind = linear ? G::Kind::Linear : G::Kind::Radial;
+
+        size_t first = 0;
+        if (linear ? lineDirection(g, StringUtils::toLower(args[0]))
+                   : radialShape(g, StringUtils::toLower(args[0])))
+            first = 1;
+
+        for (size_t i = first; i < args.size(); ++i)
+            addStops(g, args[i]);
+
+        if (g.stops.empty()) { CSS_TRACE_COUNT(ParseFailures); g.kind = G::Kind::None; }
+        return g;
+    }
+
+private:
+    // "90deg", "0.25turn", "to left", "to bottom right" — false if `a` is a stop
+    static bool lineDirection(contracts::Gradient& g, const std::string& a) {
+        if (a.rfind("to ", 0) == 0) {
+            int x = 0, y = 0;
+            for (const auto& w : StringUtils::splitTopLevel(a.substr(3), ' ')) {
+                if      (w == "left")   x = -1;
+                else if (w == "right")  x =  1;
+                else if (w == "top")    y = -1;
+                else if (w == "bottom") y =  1;
+            }
+            if (x && y)      g.corner = { x, y };
+            else if (x)      g.angle  = x > 0 ? 90.f : 270.f;
+            else if (y)      g.angle  = y > 0 ? 180.f : 0.f;
+            return true;
+        }
+
+        static const struct { const char* unit; float toDeg; } units[] = {
+            { "deg", 1.f }, { "grad", 0.9f }, { "rad", 57.29578f }, { "turn", 360.f }
+        };
+        for (const auto& u : units) {
+            const size_t n = std::strlen(u.unit);
+            if (a.size() > n && a.compare(a.size() - n, n, u.unit) == 0
+                && !std::isalpha(static_cast<unsigned char>(a[a.size() - n - 1]))) {
+                g.angle = LengthResolver::parseAbsolute(a.substr(0, a.size() - n)) * u.toDeg;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // "circle", "ellipse farthest-side", "closest-corner at 25% top" — false if `a` is a stop
+    static bool radialShape(contracts::Gradient& g, const std::string& a) {
+        using G = contracts::Gradient;
+        const auto words = StringUtils::splitTopLevel(a, ' ');
+        bool matched = false;
+        for (size_t i = 0; i < words.size(); ++i) {
+            const std::string& w = words[i];
+            if      (w == "circle")          { g.shape  = G::Shape::Circle;          matched = true; }
+            else if (w == "ellipse")         { g.shape  = G::Shape::Ellipse;         matched = true; }
+            else if (w == "closest-side")    { g.extent = G::Extent::ClosestSide;    matched = true; }
+            else if (w == "closest-corner")  { g.extent = G::Extent::ClosestCorner;  matched = true; }
+            else if (w == "farthest-side")   { g.extent = G::Extent::FarthestSide;   matched = true; }
+            else if (w == "farthest-corner") { g.extent = G::Extent::FarthestCorner; matched = true; }
+            else if (w == "at") {
+                position(g, std::vector<std::string>(words.begin() + i + 1, words.end()));
+                return true;
+            }
+            else if (!matched) return false;
+        }
+        return matched;
+    }
+
+    // "left", "30% 40%", "right top", "center bottom"
+    static void position(contracts::Gradient& g, const std::vector<std::string>& words) {
+        bool xSet = false;
+        for (const auto& w : words) {
+            if      (w == "left")   { g.center.x = 0.f; xSet = true; }
+            else if (w == "right")  { g.center.x = 1.f; xSet = true; }
+            else if (w == "top")      g.center.y = 0.f;
+            else if (w == "bottom")   g.center.y = 1.f;
+            else if (w == "center") { if (!xSet) xSet = true; }
+            else if (!w.empty() && w.back() == '%') {
+                (xSet ? g.center.y : g.center.x) = LengthResolver::resolve(w, 1.f);
+                xSet = true;
+            }
+        }
+    }
+
+    // "red", "red 40%", "rgba(0,0,0,128) 10% 30%", "#fff 12px"
+    static void addStops(contracts::Gradient& g, const std::string& arg) {
+        const auto parts = StringUtils::splitTopLevel(arg, ' ');
+        if (parts.empty()) return;
+
+        // A bare position is a color hint — not supported, skipped
+        if (isLength(parts[0])) return;
+
+        contracts::GradientStop stop;
+        stop.color = ColorParser::parse(parts[0]);
+        if (parts.size() == 1) { g.stops.push_back(stop); return; }
+
+        for (size_t i = 1; i < parts.size() && i < 3; ++i) {
+            stop.hasPosition = true;
+            stop.pixels      = parts[i].back() != '%';
+            stop.position    = stop.pixels ? LengthResolver::parseAbsolute(parts[i])
+                                           : LengthResolver::resolve(parts[i], 1.f);
+            g.stops.push_back(stop);
+        }
+    }
+
+    static bool isLength(const std::string& s) {
+        return !s.empty() && (std::isdigit(static_cast<unsigned char>(s[0])) || s[0] == '.' || s[0] == '-');
+    }
+};
+
+} // namespace utilities
@@ -0,0 +1,135 @@
+#pragma once
+#include "../contracts/GridTemplate.hpp"
+#include "LengthResolver.hpp"
+#include "StringUtils.hpp"
+#include "Trace.hpp"
+#include <SFML/System/Vector2.hpp>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+namespace utilities {
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  GridParser
+//
+//  Parses CSS Grid values into contracts::GridTemplate pieces.
+//
+//  Track lists (grid-template-columns / -rows, grid-auto-*):
+//    "200px 1fr 2fr"                      → px, fr
+//    "25% auto"                           → %, auto (min-/max-/fit-content → auto)
+//    "repeat(3, 1fr)"                     → three 1fr tracks
+//    "repeat(2, 40px minmax(80px, 1fr))"  → groups of several tracks
+//    "repeat(auto-fill, minmax(96px, 1fr))"
+//                                         → as many as fit (resolved at layout)
+//
+//  Lines (grid-column / grid-row):
+//    "2"  "2 / 4"  "span 3"  "1 / span 2"  "1 / -1"  "auto"
+//
+//  Areas (grid-area): "row-start / column-start / row-end / column-end"
+// ─────────────────────────────────────────────────────────────────────────────
+
+struct GridParser {
+
+    static contracts::GridTrackList parseTracks(const std::string& val, sf::Vector2f windowSize) {
+        contracts::GridTrackList list;
+        const std::string v = StringUtils::toLower(StringUtils::trim(val));
+        if (v.empty() || v == "none") return list;
+
+        for (const auto& tok : StringUtils::splitTopLevel(v, ' ')) {
+            if (tok.rfind("repeat(", 0) == 0 && tok.back() == ')') {
+                const std::string inner = tok.substr(7, tok.size() - 8);
+                const size_t comma = inner.find(',');
+                if (comma == std::string::npos) { CSS_TRACE_COUNT(ParseFailures); continue; }
+
+                const std::string count = StringUtils::trim(inner.substr(0, comma));
+                const auto group = parseTracks(inner.substr(comma + 1), windowSize).tracks;
+
+                if (count == "auto-fill" || count == "auto-fit") {
+                    list.autoRepeat = group;
+                    list.repeatAt   = list.tracks.size();
+                } else {
+                    const int n = std::clamp(toInt(count, 1), 1, 10000);
+                    for (int i = 0; i < n; ++i)
+                        list.tracks.insert(list.tracks.end(), group.begin(), group.end());
+                }
+            } else {
+                list.tracks.push_back(parseTrack(tok, windowSize));
+            }
+        }
+        return list;
+    }
+
+    static contracts::GridTrack parseTrack(const std::string& tok, sf::Vector2f windowSize) {
+        using K = contracts::GridTrackSize::Kind;
+        if (tok.rfind("minmax(", 0) == 0 && tok.back() == ')') {
+            const auto args = StringUtils::splitTopLevel(tok.substr(7, tok.size() - 8), ',');
+            if (args.size() == 2) {
+                contracts::GridTrack t{ parseSize(args[0], windowSize), parseSize(args[1], windowSize) };
+                if (t.min.kind == K::Fr) t.min = {};     // fr is not a valid minimum
+                return t;
+            }
+            CSS_TRACE_COUNT(ParseFailures);
+            return {};
+        }
+
+        const contracts::GridTrackSize s = parseSize(tok, windowSize);
+        if (s.kind == K::Fr) return { { K::Fixed, 0.f }, s };
+        return { s, s };
+    }
+
+    static contracts::GridTrackSize parseSize(const std::string& raw, sf::Vector2f windowSize) {
+        using K = contracts::GridTrackSize::Kind;
+        const std::string s = StringUtils::trim(raw);
+        if (s.empty() || s == "auto" || s == "min-content" || s == "max-content"
+            || s.rfind("fit-content", 0) == 0)
+            return { K::Auto, 0.f };
+        if (s.size() > 2 && s.compare(s.size() - 2, 2, "fr") == 0)
+            return { K::Fr, std::max(0.f, LengthResolver::parseAbsolute(s.substr(0, s.size() - 2))) };
+        if (s.back() == '%')
+            return { K::Percent, LengthResolver::resolve(s, 1.f) };
+        return { K::Fixed, LengthResolver::resolve(s, 0.f, windowSize) };
+    }
+
+    static contracts::GridLine parseLine(const std::string& val) {
+        contracts::GridLine line;
+        const auto sides = StringUtils::splitTopLevel(StringUtils::toLower(val), '/');
+        if (!sides.empty())    applySide(line, sides[0], true);
+        if (sides.size() > 1)  applySide(line, sides[1], false);
+        return line;
+    }
+
+    // "row-start / column-start / row-end / column-end"
+    static contracts::GridPlacement parseArea(const std::string& val) {
+        contracts::GridPlacement p;
+        const auto parts = StringUtils::splitTopLevel(StringUtils::toLower(val), '/');
+        if (parts.size() > 0) applySide(p.row,    parts[0], true);
+        if (parts.size() > 1) applySide(p.column, parts[1], true);
+        if (parts.size() > 2) applySide(p.row,    parts[2], false);
+        if (parts.size() > 3) applySide(p.column, parts[3], false);
+        return p;
+    }
+
+    // Start or end of a line: "3", "-1", "span 2", "auto"
+    static void applySide(contracts::GridLine& line, const std::string& raw, bool isStart) {
+        const std::string s = StringUtils::trim(raw);
+        if (s.empty() || s == "auto") return;
+        if (s.rfind("span", 0) == 0) {
+            line.span = std::max(1, toInt(s.substr(4), 1));
+            return;
+        }
+        (isStart ? line.start : line.end) = toInt(s, 0);
+    }
+
+private:
+    static int toInt(const std::string& s, int fallback) {
+        try {
+            return std::stoi(StringUtils::trim(s));
+        } catch (...) {
+            CSS_TRACE_COUNT(ParseFailures);
+            return fallback;
+        }
+    }
+};
+
+} // namespace utilities
@@ -1,5 +1,7 @@
 #pragma once
+#include "CalcExpression.hpp"
 #include "StringUtils.hpp"
+#include "Trace.hpp"
 #include <SFML/System/Vector2.hpp>
 #include <string>
 #include <array>
@@ -23,6 +25,9 @@ namespace utilities {
 //    pt   — treated as px
 //    auto — returns 0.f (caller handles "auto" semantics)
 //
+//  calc(), min(), max() and clamp() may combine any of these; each distinct
+//  expression is compiled once (CalcExpression) and only evaluated after.
+//
 //  Reference semantics:
 //    resolve(val, ref, windowSize)
 //      ref        = the containing block dimension (parent width for horizontal,
@@ -41,6 +46,9 @@ struct LengthResolver {
         std::string s = StringUtils::trim(val);
         if (s.empty() || s == "auto") return 0.f;
 
+        if (CalcExpression::isExpression(s))
+            return CalcExpression::compiled(s).evaluate(reference, windowSize);
+
         // Percentage
         if (!s.empty() && s.back() == '%') {
             float pct = parseNumber(s.substr(0, s.size() - 1));
@@ -60,6 +68,7 @@ struct LengthResolver {
     // Shorthand: only handle absolute units (no context needed)
     static float parseAbsolute(const std::string& val) {
         std::string s = StringUtils::trim(val);
+        if (CalcExpression::isExpression(s)) return CalcExpression::compiled(s).evaluate(0.f);
         // Strip known unit suffixes
         for (const char* unit : {"px","em","rem","pt","dp"}) {
             std::string low = StringUtils::toLower(s);
@@ -82,7 +91,7 @@ struct LengthResolver {
         float              reference,
         sf::Vector2f       windowSize = {0.f, 0.f}
     ) {
-        auto parts = StringUtils::tokenize(val);
+        auto parts = StringUtils::splitTopLevel(val, ' ');
         auto r = [&](const std::string& v){ return resolve(v, reference, windowSize); };
 
         std::array<float, 4> s{0,0,0,0};
@@ -101,6 +110,7 @@ private:
         try {
             return std::stof(StringUtils::trim(s));
         } catch (...) {
+            CSS_TRACE_COUNT(ParseFailures);
             return 0.f;
         }
     }
@@ -0,0 +1,238 @@
+#pragma once
+#include "../contracts/TextWrap.hpp"
+#include <algorithm>
+#include <string>
+#include <vector>
+
+namespace utilities {
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  LineBreaker
+//
+//  Greedy line breaking over UTF-32 text in one linear pass. Knows nothing
+//  about fonts — the caller supplies the pen advance of each code point:
+//
+//    float advance(char32_t previous, char32_t current);
+//      previous == 0 at the start of a line; the result should include any
+//      kerning between the pair.
+//
+//  Behaviour per contracts::TextWrap:
+//    • white-space collapses or preserves spaces/newlines before breaking
+//    • lines break after the last space that still fits; spaces at the end
+//      of a line hang past the edge and never force a break
+//    • overflow-wrap: break-word splits a word only when it alone overflows
+//    • text-overflow: ellipsis truncates any line still wider than maxWidth
+//
+//  maxWidth <= 0 means unconstrained: only white-space processing applies.
+//
+//  minContentWidth() is the narrowest maxWidth wrap() lays the text out in
+//  without splitting a word or truncating a line.
+// ─────────────────────────────────────────────────────────────────────────────
+
+struct LineBreaker {
+
+    static constexpr char32_t kEllipsis = U'\u2026';    // …
+
+    template<typename Advance>
+    static std::u32string wrap(
+        const std::u32string&       source,
+        float                       maxWidth,
+        const contracts::TextWrap&  opts,
+        Advance&&                   advance
+    ) {
+        const std::u32string text = collapse(source, opts.whiteSpace);
+        const bool wrapping  = opts.wraps() && maxWidth > 0.f;
+        const bool breakWord = opts.overflowWrap == contracts::TextWrap::OverflowWrap::BreakWord;
+
+        std::vector<Line> lines;
+        size_t   lineStart   = 0;
+        size_t   breakAt     = std::u32string::npos; // last space on this line
+        float    x           = 0.f;
+        float    beforeBreak = 0.f;                  // line width up to breakAt
+        float    sinceBreak  = 0.f;                  // width after breakAt
+        char32_t prev        = 0;
+
+        for (size_t i = 0; i < text.size(); ++i) {
+            const char32_t c = text[i];
+
+            if (c == U'\n') {
+                lines.push_back({ lineStart, i, x });
+                lineStart = i + 1;
+                breakAt   = std::u32string::npos;
+                x = sinceBreak = 0.f;
+                prev = 0;
+                continue;
+            }
+
+            float adv = advance(prev, c);
+
+            if (wrapping && isSpace(c)) {
+                beforeBreak = x;
+                x          += adv;
+                breakAt     = i;
+                sinceBreak  = 0.f;
+                prev        = c;
+                continue;
+            }
+
+            if (wrapping && i > lineStart && x + adv > maxWidth) {
+                if (breakAt != std::u32string::npos) {
+                    lines.push_back({ lineStart, breakAt, beforeBreak });
+                    lineStart = breakAt + 1;
+                    breakAt   = std::u32string::npos;
+                    x         = sinceBreak;
+                    prev      = lineStart < i ? text[i - 1] : 0;
+                    adv       = advance(prev, c);
+                }
+                if (breakWord && i > lineStart && x + adv > maxWidth) {
+                    lines.push_back({ lineStart, i, x });
+                    lineStart = i;
+                    x    = 0.f;
+                    prev = 0;
+                    adv  = advance(prev, c);
+                }
+            }
+
+            x          += adv;
+            sinceBreak += adv;
+            prev        = c;
+        }
+        lines.push_back({ lineStart, text.size(), x });
+
+        const bool ellipsis = maxWidth > 0.f
+            && opts.textOverflow == contracts::TextWrap::TextOverflow::Ellipsis;
+
+        std::u32string out;
+        out.reserve(text.size() + lines.size());
+        for (size_t l = 0; l < lines.size(); ++l) {
+            if (l > 0) out += U'\n';
+            const Line& line = lines[l];
+            if (ellipsis && visibleWidth(text, line, advance) > maxWidth)
+                appendTruncated(out, text, line, maxWidth, advance);
+            else
+                out.append(text, line.begin, line.end - line.begin);
+        }
+        return out;
+    }
+
+    // Widest word when the white-space mode wraps, widest line otherwise.
+    // Words are measured as wrap() measures them (from the preceding space,
+    // or from the line start), so wrap() at this width never splits one;
+    // break-word opportunities don't count, as in CSS.
+    template<typename Advance>
+    static float minContentWidth(
+        const std::u32string&       source,
+        const contracts::TextWrap&  opts,
+        Advance&&                   advance
+    ) {
+        const std::u32string text = collapse(source, opts.whiteSpace);
+        const bool wrapping = opts.wraps();
+
+        float    widest  = 0.f;
+        float    x       = 0.f;
+        float    visible = 0.f;     // x after the last non-space
+        char32_t prev    = 0;
+        for (const char32_t c : text) {
+            if (c == U'\n') {
+                widest = std::max(widest, visible);
+                x = visible = 0.f;
+                prev = 0;
+                continue;
+            }
+            const float adv = advance(prev, c);
+            prev = c;
+            if (isSpace(c)) {
+                if (wrapping) {
+                    widest = std::max(widest, visible);
+                    x = visible = 0.f;
+                } else {
+                    x += adv;
+                }
+                continue;
+            }
+            x      += adv;
+            visible = x;
+        }
+        return std::max(widest, visible);
+    }
+
+    // Applies the white-space collapsing rules without breaking.
+    static std::u32string collapse(const std::u32string& s, contracts::TextWrap::WhiteSpace mode) {
+        using WS = contracts::TextWrap::WhiteSpace;
+        if (mode == WS::Pre || mode == WS::PreWrap) return s;
+
+        const bool keepNewlines = (mode == WS::PreLine);
+        std::u32string out;
+        out.reserve(s.size());
+
+        bool pendingSpace = false;
+        for (char32_t c : s) {
+            if (c == U'\n' && keepNewlines) {
+                pendingSpace = false;
+                out += U'\n';
+            }
+            else if (isSpace(c) || c == U'\n' || c == U'\r') {
+                pendingSpace = true;
+            }
+            else {
+                if (pendingSpace && !out.empty() && out.back() != U'\n')
+                    out += U' ';
+                pendingSpace = false;
+                out += c;
+            }
+        }
+        return out;
+    }
+
+private:
+    struct Line {
+        size_t begin, end;
+        float  width;   // includes trailing (hanging) spaces
+    };
+
+    static bool isSpace(char32_t c) { return c == U' ' || c == U'\t'; }
+
+    // Width without hanging spaces — only needed for the ellipsis check.
+    template<typename Advance>
+    static float visibleWidth(const std::u32string& text, const Line& line, Advance& advance) {
+        size_t end = line.end;
+        while (end > line.begin && isSpace(text[end - 1])) --end;
+        if (end == line.end) return line.width;
+
+        float    w    = 0.f;
+        char32_t prev = 0;
+        for (size_t i = line.begin; i < end; ++i) {
+            w   += advance(prev, text[i]);
+            prev = text[i];
+        }
+        return w;
+    }
+
+    template<typename Advance>
+    static void appendTruncated(
+        std::u32string&       out,
+        const std::u32string& text,
+        const Line&           line,
+        float                 maxWidth,
+        Advance&              advance
+    ) {
+        float    x    = 0.f;
+        char32_t prev = 0;
+        size_t   i    = line.begin;
+        for (; i < line.end; ++i) {
+            const float adv  = advance(prev, text[i]);
+            const float tail = advance(text[i], kEllipsis);
+            if (x + adv + tail > maxWidth) break;
+            x   += adv;
+            prev = text[i];
+        }
+        // Don't leave a dangling space before the ellipsis
+        size_t end = i;
+        while (end > line.begin && isSpace(text[end - 1])) --end;
+
+        out.append(text, line.begin, end - line.begin);
+        out += kEllipsis;
+    }
+};
+
+} // namespace utilities
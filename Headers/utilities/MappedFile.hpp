@@ -0,0 +1,143 @@
+#pragma once
+#include <cstddef>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(_WIN32)
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #ifndef WIN32_LEAN_AND_MEAN
+        #define WIN32_LEAN_AND_MEAN
+    #endif
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace utilities {
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  MappedFile
+//
+//  Read-only view of a whole file. Memory-mapped where the OS allows it,
+//  otherwise read into an owned buffer — callers only see data()/size().
+//
+//  Move-only; the view stays valid for the lifetime of the object, which is
+//  what sf::Font::openFromMemory requires of its buffer.
+// ─────────────────────────────────────────────────────────────────────────────
+
+class MappedFile {
+public:
+    MappedFile() = default;
+    explicit MappedFile(const std::string& path) { open(path); }
+    ~MappedFile() { close(); }
+
+    MappedFile(const MappedFile&)            = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    MappedFile(MappedFile&& o) noexcept { swap(o); }
+    MappedFile& operator=(MappedFile&& o) noexcept {
+        if (this != &o) { close(); swap(o); }
+        return *this;
+    }
+
+    bool open(const std::string& path) {
+        close();
+        if (map(path)) return true;
+        return readFallback(path);
+    }
+
+    void close() {
+#if defined(_WIN32)
+        if (view_)    UnmapViewOfFile(view_);
+        if (mapping_) CloseHandle(mapping_);
+        view_    = nullptr;
+        mapping_ = nullptr;
+#else
+        if (view_) munmap(view_, size_);
+        view_ = nullptr;
+#endif
+        buffer_.clear();
+        buffer_.shrink_to_fit();
+        size_ = 0;
+    }
+
+    [[nodiscard]] const void*  data()     const { return view_ ? view_ : buffer_.data(); }
+    [[nodiscard]] std::size_t  size()     const { return size_; }
+    [[nodiscard]] bool         isOpen()   const { return size_ > 0; }
+    [[nodiscard]] bool         isMapped() const { return view_ != nullptr; }
+
+private:
+    bool map(const std::string& path) {
+#if defined(_WIN32)
+        HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                                  OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) return false;
+
+        LARGE_INTEGER sz{};
+        if (!GetFileSizeEx(file, &sz) || sz.QuadPart == 0) { CloseHandle(file); return false; }
+
+        mapping_ = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        CloseHandle(file);
+        if (!mapping_) return false;
+
+        view_ = MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0);
+        if (!view_) { CloseHandle(mapping_); mapping_ = nullptr; return false; }
+        size_ = static_cast<std::size_t>(sz.QuadPart);
+        return true;
+#else
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+
+        struct stat st{};
+        if (fstat(fd, &st) != 0 || st.st_size <= 0) { ::close(fd); return false; }
+
+        void* p = mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (p == MAP_FAILED) return false;
+
+        view_ = p;
+        size_ = static_cast<std::size_t>(st.st_size);
+        return true;
+#endif
+    }
+
+    bool readFallback(const std::string& path) {
+        std::ifstream in(path, std::ios::binary | std::ios::ate);
+        if (!in) return false;
+        const auto len = static_cast<std::size_t>(in.tellg());
+        if (len == 0) return false;
+        buffer_.resize(len);
+        in.seekg(0);
+        if (!in.read(buffer_.data(), static_cast<std::streamsize>(len))) {
+            buffer_.clear();
+            return false;
+        }
+        size_ = len;
+        return true;
+    }
+
+    void swap(MappedFile& o) noexcept {
+        std::swap(view_, o.view_);
+        std::swap(size_, o.size_);
+        std::swap(buffer_, o.buffer_);
+#if defined(_WIN32)
+        std::swap(mapping_, o.mapping_);
+#endif
+    }
+
+    void*             view_ = nullptr;
+    std::size_t       size_ = 0;
+    std::vector<char> buffer_;
+#if defined(_WIN32)
+    HANDLE            mapping_ = nullptr;
+#endif
+};
+
+} // namespace utilities
@@ -0,0 +1,84 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+namespace utilities {
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  MpscRing<T>
+//
+//  Bounded lock-free queue: any number of threads push(), one thread pop()s.
+//  Each cell carries a sequence number telling whose turn it is (the
+//  producer that claimed this lap, or the consumer), so producers only
+//  race on one fetch of the tail counter and never block each other or
+//  the consumer; push() on a full ring fails instead of waiting.
+//
+//  The capacity is rounded up to a power of two.
+// ─────────────────────────────────────────────────────────────────────────────
+
+template<typename T>
+class MpscRing {
+public:
+    explicit MpscRing(std::size_t capacity) {
+        std::size_t n = 2;
+        while (n < capacity) n <<= 1;
+        mask_  = n - 1;
+        cells_ = std::make_unique<Cell[]>(n);
+        for (std::size_t i = 0; i < n; ++i) cells_[i].seq.store(i, std::memory_order_relaxed);
+    }
+
+    MpscRing(const MpscRing&)            = delete;
+    MpscRing& operator=(const MpscRing&) = delete;
+
+    // Any thread; false when full
+    bool push(T value) {
+        std::size_t pos = tail_.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& c = cells_[pos & mask_];
+            const std::size_t seq = c.seq.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+            if (diff == 0) {
+                if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    c.value = std::move(value);
+                    c.seq.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;                                   // a lap behind: full
+            } else {
+                pos = tail_.load(std::memory_order_relaxed);    // another producer took it
+            }
+        }
+    }
+
+    // Consumer thread only; false when empty (or the next cell is still
+    // being written)
+    bool pop(T& out) {
+        Cell& c = cells_[head_ & mask_];
+        if (c.seq.load(std::memory_order_acquire) != head_ + 1) return false;
+        out = std::move(c.value);
+        c.value = T{};
+        c.seq.store(head_ + mask_ + 1, std::memory_order_release);
+        ++head_;
+        return true;
+    }
+
+    [[nodiscard]] std::size_t capacity() const { return mask_ + 1; }
+
+private:
+    struct Cell {
+        std::atomic<std::size_t> seq{ 0 };
+        T                        value{};
+    };
+
+    static constexpr std::size_t kLine = 64;
+
+    std::unique_ptr<Cell[]>                  cells_;
+    std::size_t                              mask_ = 0;
+    alignas(kLine) std::atomic<std::size_t>  tail_{ 0 };    // producers
+    alignas(kLine) std::size_t               head_ = 0;     // consumer
+};
+
+} // namespace utilities
@@ -0,0 +1,193 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <vector>
+
+// Four-lane float SIMD for the blur passes: SSE2 on x86-64, NEON on ARM.
+// Define CSS_SFML_NO_SIMD to force the scalar path.
+#if !defined(CSS_SFML_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#  include <emmintrin.h>
+#  define CSS_SFML_BLUR_SSE2 1
+#elif !defined(CSS_SFML_NO_SIMD) && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+#  include <arm_neon.h>
+#  define CSS_SFML_BLUR_NEON 1
+#endif
+
+namespace utilities {
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  ShadowBlur
+//
+//  Gaussian blur of a single-channel float plane (a shadow's coverage mask),
+//  approximated by three box blurs per axis — within a few percent of a
+//  true gaussian, at a cost independent of the radius.
+//
+//  Each box pass is a running sum down the columns, so one step updates a
+//  whole row of sums: contiguous floats, four at a time with SIMD. The
+//  horizontal passes run the same column code on the transposed plane.
+//  Samples outside the plane count as 0, so a mask padded by reach() blurs
+//  without edge artifacts.
+//
+//  blurReference() is the plain scalar version of the same passes. Both
+//  perform the same float operations in the same order, so their results
+//  match exactly; it exists to check and benchmark blur().
+// ─────────────────────────────────────────────────────────────────────────────
+
+struct ShadowBlur {
+    static constexpr int kPasses = 3;
+
+    // Box radii whose combined response has standard deviation ≈ sigma
+    static std::array<int, kPasses> boxRadii(float sigma) {
+        std::array<int, kPasses> radii{};
+        if (sigma <= 0.f) return radii;
+        const float n     = static_cast<float>(kPasses);
+        const float ideal = std::sqrt(12.f * sigma * sigma / n + 1.f);
+        int lower = static_cast<int>(std::floor(ideal));
+        if (lower % 2 == 0) --lower;
+        const float lw = static_cast<float>(lower);
+        const int   m  = static_cast<int>(std::round(
+            (12.f * sigma * sigma - n * lw * lw - 4.f * n * lw - 3.f * n) / (-4.f * lw - 4.f)));
+        for (int i = 0; i < kPasses; ++i)
+            radii[i] = ((i < m ? lower : lower + 2) - 1) / 2;
+        return radii;
+    }
+
+    // How far the blurred result spreads past the input on each side
+    static int reach(float sigma) {
+        const auto r = boxRadii(sigma);
+        return r[0] + r[1] + r[2];
+    }
+
+    // In-place blur of a w×h plane (row-major)
+    static void blur(std::vector<float>& plane, int w, int h, float sigma) {
+        run(plane, w, h, sigma, &columnsSimd);
+    }
+
+    static void blurReference(std::vector<float>& plane, int w, int h, float sigma) {
+        run(plane, w, h, sigma, &columnsScalar);
+    }
+
+    [[nodiscard]] static constexpr bool vectorized() { return kLanes > 1; }
+
+private:
+    using ColumnPass = void (*)(const float* src, float* dst, float* acc, const float* zero,
+                                int w, int h, int r);
+
+    static void run(std::vector<float>& plane, int w, int h, float sigma, ColumnPass pass) {
+        const auto radii = boxRadii(sigma);
+        if (w <= 0 || h <= 0 || radii[0] + radii[1] + radii[2] == 0) return;
+
+        std::vector<float> other(plane.size());
+        std::vector<float> scratch(static_cast<std::size_t>(std::max(w, h)) * 2, 0.f);
+        float*       acc  = scratch.data();
+        const float* zero = scratch.data() + std::max(w, h);
+
+        auto passes = [&](int pw, int ph) {
+            for (int r : radii) {
+                if (r <= 0) continue;
+                pass(plane.data(), other.data(), acc, zero, pw, ph, r);
+                plane.swap(other);
+            }
+        };
+        transpose(plane.data(), other.data(), w, h);
+        plane.swap(other);
+        passes(h, w);                                   // horizontal
+        transpose(plane.data(), other.data(), h, w);
+        plane.swap(other);
+        passes(w, h);                                   // vertical
+    }
+
+    // dst[y] = mean of src[y - r .. y + r], per column; rows outside read `zero`
+    static void columnsScalar(const float* src, float* dst, float* acc, const float* zero,
+                              int w, int h, int r) {
+        const float inv = 1.f / static_cast<float>(2 * r + 1);
+        std::fill(acc, acc + w, 0.f);
+        for (int y = 0; y < std::min(r, h); ++y)
+            for (int x = 0; x < w; ++x) acc[x] += src[y * w + x];
+
+        for (int y = 0; y < h; ++y) {
+            const float* in  = y + r <  h ? src + (y + r) * w : zero;
+            const float* out = y - r >= 0 ? src + (y - r) * w : zero;
+            float*       d   = dst + y * w;
+            for (int x = 0; x < w; ++x) {
+                acc[x] += in[x];
+                d[x]    = acc[x] * inv;
+                acc[x] -= out[x];
+            }
+        }
+    }
+
+#if defined(CSS_SFML_BLUR_SSE2)
+    static constexpr int kLanes = 4;
+    using Lane = __m128;
+    static Lane load (const float* p)    { return _mm_loadu_ps(p); }
+    static void store(float* p, Lane v)  { _mm_storeu_ps(p, v); }
+    static Lane add  (Lane a, Lane b)    { return _mm_add_ps(a, b); }
+    static Lane sub  (Lane a, Lane b)    { return _mm_sub_ps(a, b); }
+    static Lane mul  (Lane a, Lane b)    { return _mm_mul_ps(a, b); }
+    static Lane splat(float v)           { return _mm_set1_ps(v); }
+#elif defined(CSS_SFML_BLUR_NEON)
+    static constexpr int kLanes = 4;
+    using Lane = float32x4_t;
+    static Lane load (const float* p)    { return vld1q_f32(p); }
+    static void store(float* p, Lane v)  { vst1q_f32(p, v); }
+    static Lane add  (Lane a, Lane b)    { return vaddq_f32(a, b); }
+    static Lane sub  (Lane a, Lane b)    { return vsubq_f32(a, b); }
+    static Lane mul  (Lane a, Lane b)    { return vmulq_f32(a, b); }
+    static Lane splat(float v)           { return vdupq_n_f32(v); }
+#else
+    static constexpr int kLanes = 1;
+#endif
+
+#if defined(CSS_SFML_BLUR_SSE2) || defined(CSS_SFML_BLUR_NEON)
+    static void columnsSimd(const float* src, float* dst, float* acc, const float* zero,
+                            int w, int h, int r) {
+        const float inv  = 1.f / static_cast<float>(2 * r + 1);
+        const Lane  vinv = splat(inv);
+        const int   wv   = w - w % kLanes;
+        std::fill(acc, acc + w, 0.f);
+        for (int y = 0; y < std::min(r, h); ++y) {
+            const float* row = src + y * w;
+            int x = 0;
+            for (; x < wv; x += kLanes) store(acc + x, add(load(acc + x), load(row + x)));
+            for (; x < w; ++x) acc[x] += row[x];
+        }
+
+        for (int y = 0; y < h; ++y) {
+            const float* in  = y + r <  h ? src + (y + r) * w : zero;
+            const float* out = y - r >= 0 ? src + (y - r) * w : zero;
+            float*       d   = dst + y * w;
+            int x = 0;
+            for (; x < wv; x += kLanes) {
+                const Lane a = add(load(acc + x), load(in + x));
+                store(d + x, mul(a, vinv));
+                store(acc + x, sub(a, load(out + x)));
+            }
+            for (; x < w; ++x) {
+                acc[x] += in[x];
+                d[x]    = acc[x] * inv;
+                acc[x] -= out[x];
+            }
+        }
+    }
+#else
+    static void columnsSimd(const float* src, float* dst, float* acc, const float* zero,
+                            int w, int h, int r) {
+        columnsScalar(src, dst, acc, zero, w, h, r);
+    }
+#endif
+
+    // Cache-blocked transpose of a w×h plane into an h×w one
+    static void transpose(const float* src, float* dst, int w, int h) {
+        constexpr int kBlock = 16;
+        for (int by = 0; by < h; by += kBlock)
+            for (int bx = 0; bx < w; bx += kBlock) {
+                const int ey = std::min(by + kBlock, h), ex = std::min(bx + kBlock, w);
+                for (int y = by; y < ey; ++y)
+                    for (int x = bx; x < ex; ++x) dst[x * h + y] = src[y * w + x];
+            }
+    }
+};
+
+} // namespace utilities
@@ -0,0 +1,134 @@
+#pragma once
+#include <SFML/System/Vector2.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <vector>
+
+namespace utilities {
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  SkylinePacker
+//
+//  Online rectangle packer for texture atlases (skyline, bottom-left rule).
+//  The free space is kept as a "skyline": the top edge of everything packed
+//  so far, as a list of horizontal segments. A new rectangle goes where it
+//  rests lowest; ties go to the position that leaves the least area
+//  trapped beneath it. Inserting is O(segments), and segments stay few
+//  because neighbours at the same height are merged.
+//
+//  Space under an overhang is never reused — the trade-off for speed that
+//  suits atlases filled with many small, similarly sized images.
+// ─────────────────────────────────────────────────────────────────────────────
+
+class SkylinePacker {
+public:
+    SkylinePacker() = default;
+    SkylinePacker(unsigned width, unsigned height) { reset(width, height); }
+
+    void reset(unsigned width, unsigned height) {
+        width_  = width;
+        height_ = height;
+        used_   = 0;
+        skyline_.assign(1, Segment{ 0, 0, width });
+    }
+
+    // Top-left corner for a w × h rectangle, or nullopt if it doesn't fit
+    std::optional<sf::Vector2u> insert(unsigned w, unsigned h) {
+        if (w == 0 || h == 0 || w > width_ || h > height_) return std::nullopt;
+
+        std::size_t best = npos;
+        unsigned bestY = std::numeric_limits<unsigned>::max();
+        unsigned bestWaste = std::numeric_limits<unsigned>::max();
+
+        for (std::size_t i = 0; i < skyline_.size(); ++i) {
+            unsigned y = 0, waste = 0;
+            if (!fits(i, w, h, y, waste)) continue;
+            if (y < bestY || (y == bestY && waste < bestWaste)) {
+                best = i; bestY = y; bestWaste = waste;
+            }
+        }
+        if (best == npos) return std::nullopt;
+
+        const sf::Vector2u at{ skyline_[best].x, bestY };
+        place(best, at.x, at.y + h, w);
+        used_ += static_cast<std::uint64_t>(w) * h;
+        return at;
+    }
+
+    [[nodiscard]] unsigned      width()     const { return width_; }
+    [[nodiscard]] unsigned      height()    const { return height_; }
+    [[nodiscard]] std::uint64_t usedArea()  const { return used_; }
+
+    // Packed area over the area below the skyline's highest point
+    [[nodiscard]] double occupancy() const {
+        unsigned top = 0;
+        for (const auto& s : skyline_) top = std::max(top, s.y);
+        return top ? static_cast<double>(used_) / (static_cast<double>(width_) * top) : 0.0;
+    }
+
+private:
+    struct Segment { unsigned x, y, width; };
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+    // Can a w × h rect sit with its left edge at segment i? y = resting height
+    bool fits(std::size_t i, unsigned w, unsigned h, unsigned& y, unsigned& waste) const {
+        const unsigned x = skyline_[i].x;
+        if (x + w > width_) return false;
+
+        unsigned remaining = w;
+        y = skyline_[i].y;
+        for (std::size_t j = i; remaining > 0; ++j) {
+            if (j >= skyline_.size()) return false;
+            y = std::max(y, skyline_[j].y);
+            if (y + h > height_) return false;
+            remaining -= std::min(remaining, skyline_[j].width);
+        }
+
+        // Area left unusable beneath the new rectangle
+        waste = 0;
+        remaining = w;
+        for (std::size_t j = i; remaining > 0; ++j) {
+            const unsigned span = std::min(remaining, skyline_[j].width);
+            waste += (y - skyline_[j].y) * span;
+            remaining -= span;
+        }
+        return true;
+    }
+
+    // Raises the skyline to `top` over [x, x + w) starting at segment i
+    void place(std::size_t i, unsigned x, unsigned top, unsigned w) {
+        skyline_.insert(skyline_.begin() + static_cast<std::ptrdiff_t>(i), Segment{ x, top, w });
+
+        // Trim or drop the segments now covered
+        for (std::size_t j = i + 1; j < skyline_.size();) {
+            Segment& s = skyline_[j];
+            const unsigned end = x + w;
+            if (s.x >= end) break;
+            const unsigned cut = std::min(end - s.x, s.width);
+            if (cut == s.width) { skyline_.erase(skyline_.begin() + static_cast<std::ptrdiff_t>(j)); continue; }
+            s.x += cut;
+            s.width -= cut;
+            break;
+        }
+
+        // Merge neighbours at the same height
+        for (std::size_t j = 0; j + 1 < skyline_.size();) {
+            if (skyline_[j].y == skyline_[j + 1].y) {
+                skyline_[j].width += skyline_[j + 1].width;
+                skyline_.erase(skyline_.begin() + static_cast<std::ptrdiff_t>(j + 1));
+            } else {
+                ++j;
+            }
+        }
+    }
+
+    unsigned             width_  = 0;
+    unsigned             height_ = 0;
+    std::uint64_t        used_   = 0;
+    std::vector<Segment> skyline_;
+};
+
+} // namespace utilities
@@ -4,6 +4,7 @@
 #include <sstream>
 #include <algorithm>
 #include <unordered_map>
+#include <cstdint>
 
 namespace utilities {
 
@@ -38,6 +39,30 @@ struct StringUtils {
         return tokens;
     }
 
+    // Splits on `sep` outside parentheses; with ' ' runs of whitespace count once.
+    //   splitTopLevel("minmax(1px, 2fr), 3px", ',') → {"minmax(1px, 2fr)", "3px"}
+    static std::vector<std::string> splitTopLevel(const std::string& s, char sep) {
+        std::vector<std::string> out;
+        std::string cur;
+        int depth = 0;
+        for (char c : s) {
+            if (c == '(') ++depth;
+            else if (c == ')') --depth;
+
+            const bool split = depth == 0 && (sep == ' ' ? (c == ' ' || c == '\t') : c == sep);
+            if (split) {
+                cur = trim(cur);
+                if (!cur.empty()) out.push_back(cur);
+                cur.clear();
+            } else {
+                cur += c;
+            }
+        }
+        cur = trim(cur);
+        if (!cur.empty()) out.push_back(cur);
+        return out;
+    }
+
     // Extract all integer numeric values in order: "rgb(255, 128, 0)" → {255,128,0}
     static std::vector<int> extractIntegers(const std::string& s) {
         std::vector<int> nums;
@@ -55,6 +80,16 @@ struct StringUtils {
         return nums;
     }
 
+    // FNV-1a over a UTF-32 buffer — used to detect text changes cheaply
+    static std::uint64_t hash(const char32_t* data, std::size_t n) {
+        std::uint64_t h = 0xcbf29ce484222325ull;
+        for (std::size_t i = 0; i < n; ++i) {
+            h ^= static_cast<std::uint64_t>(data[i]);
+            h *= 0x100000001b3ull;
+        }
+        return h;
+    }
+
     // Normalise property names: accept both camelCase and kebab-case inputs
     // "backgroundColor" → "background-color"
     // "background-color" → "background-color" (passthrough)
@@ -72,6 +107,15 @@ struct StringUtils {
             {"borderwidth",         "border-width"},
             {"outlinethickness",    "border-width"},
             {"borderradius",        "border-radius"},
+            {"bordertopleftradius",     "border-top-left-radius"},
+            {"bordertoprightradius",    "border-top-right-radius"},
+            {"borderbottomrightradius", "border-bottom-right-radius"},
+            {"borderbottomleftradius",  "border-bottom-left-radius"},
+            {"boxshadow",           "box-shadow"},
+            {"borderimage",         "border-image"},
+            {"borderimagesource",   "border-image-source"},
+            {"borderimageslice",    "border-image-slice"},
+            {"borderimagewidth",    "border-image-width"},
             // font / text
             {"fontsize",            "font-size"},
             {"fontfamily",          "font-family"},
@@ -79,6 +123,10 @@ struct StringUtils {
             {"textdecoration",      "text-decoration"},
             {"letterspacing",       "letter-spacing"},
             {"linespacing",         "line-spacing"},
+            {"whitespace",          "white-space"},
+            {"overflowwrap",        "overflow-wrap"},
+            {"wordwrap",            "word-wrap"},
+            {"textoverflow",        "text-overflow"},
             // layout
             {"marginleft",          "margin-left"},
             {"margintop",           "margin-top"},
@@ -94,10 +142,30 @@ struct StringUtils {
             {"maxheight",           "max-height"},
             // flex
             {"flexdirection",       "flex-direction"},
+            {"flexwrap",            "flex-wrap"},
+            {"flexflow",            "flex-flow"},
+            {"flexgrow",            "flex-grow"},
+            {"flexshrink",          "flex-shrink"},
+            {"flexbasis",           "flex-basis"},
             {"justifycontent",      "justify-content"},
             {"alignitems",          "align-items"},
             {"rowgap",              "row-gap"},
             {"columngap",           "column-gap"},
+            // grid
+            {"gridtemplatecolumns", "grid-template-columns"},
+            {"gridtemplaterows",    "grid-template-rows"},
+            {"gridautocolumns",     "grid-auto-columns"},
+            {"gridautorows",        "grid-auto-rows"},
+            {"gridautoflow",        "grid-auto-flow"},
+            {"gridcolumn",          "grid-column"},
+            {"gridrow",             "grid-row"},
+            {"gridcolumnstart",     "grid-column-start"},
+            {"gridcolumnend",       "grid-column-end"},
+            {"gridrowstart",        "grid-row-start"},
+            {"gridrowend",          "grid-row-end"},
+            {"gridarea",            "grid-area"},
+            {"justifyitems",        "justify-items"},
+            {"zindex",              "z-index"},
             // transform
             {"scalex",              "scale-x"},
             {"scaley",              "scale-y"},
@@ -106,7 +174,11 @@ struct StringUtils {
             {"pointcount",          "point-count"},
         };
 
-        std::string lower = toLower(trim(prop));
+        // Custom properties are case-sensitive and never aliased
+        std::string trimmed = trim(prop);
+        if (trimmed.rfind("--", 0) == 0) return trimmed;
+
+        std::string lower = toLower(trimmed);
         // Strip all hyphens for lookup (so "background-color" also matches)
         std::string noHyphen;
         for (char c : lower)
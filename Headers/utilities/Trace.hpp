@@ -0,0 +1,220 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace utilities {
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  Trace
+//
+//  Opt-in instrumentation: scoped timing zones plus a fixed set of counters,
+//  exported as Chrome trace-event JSON (chrome://tracing, ui.perfetto.dev).
+//
+//  Compiled out unless CSS_SFML_TRACE is defined before including CSS.hpp:
+//    #define CSS_SFML_TRACE
+//    #include <CSS.hpp>
+//
+//  Instrumentation points use the macros below, never Trace directly, so a
+//  release build carries no timing calls and no counter increments:
+//    CSS_TRACE_ZONE("RuleParser::parse");
+//    CSS_TRACE_COUNT(UnknownProperties);
+//    CSS_TRACE_COUNT_N(DeclarationsProcessed, decls.size());
+//
+//  Output layout:
+//    • one complete event ("ph":"X") per closed zone
+//    • one counter event ("ph":"C") per counter, sampled whenever an
+//      outermost zone closes — viewers plot these as stacked tracks
+// ─────────────────────────────────────────────────────────────────────────────
+
+struct Trace {
+
+    enum class Counter : std::size_t {
+        DeclarationsProcessed,
+        AdapterAllocations,
+        SfmlSetterCalls,
+        ParseFailures,
+        UnknownProperties,
+        Count_
+    };
+
+    // ── Scoped zone ───────────────────────────────────────────────────────
+    class Zone {
+    public:
+        explicit Zone(const char* name)
+            : name_(name), start_(nowMicros()) { ++depth(); }
+
+        ~Zone() {
+            const std::int64_t end = nowMicros();
+            const bool outermost   = (--depth() == 0);
+            record(name_, start_, end - start_, outermost);
+        }
+
+        Zone(const Zone&)            = delete;
+        Zone& operator=(const Zone&) = delete;
+
+    private:
+        const char*  name_;
+        std::int64_t start_;
+    };
+
+    static void count(Counter c, std::uint64_t n = 1) {
+        counters()[static_cast<std::size_t>(c)].fetch_add(n, std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] static std::uint64_t value(Counter c) {
+        return counters()[static_cast<std::size_t>(c)].load(std::memory_order_relaxed);
+    }
+
+    // Drops recorded zones and zeroes every counter.
+    static void reset() {
+        std::lock_guard<std::mutex> lock(storage().mutex);
+        storage().events.clear();
+        for (auto& c : counters()) c.store(0, std::memory_order_relaxed);
+    }
+
+    // Writes everything recorded so far. Returns false when the file cannot
+    // be opened or when tracing was compiled out (nothing to write).
+    static bool dump(const std::string& path) {
+#if !defined(CSS_SFML_TRACE)
+        (void)path;
+        return false;
+#else
+        std::ofstream out(path, std::ios::trunc);
+        if (!out) return false;
+
+        std::lock_guard<std::mutex> lock(storage().mutex);
+        out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+        bool first = true;
+        for (const auto& e : storage().events) {
+            out << (first ? "" : ",") << '\n';
+            first = false;
+            if (e.isCounter) {
+                out << "{\"name\":\"" << counterName(e.counter)
+                    << "\",\"ph\":\"C\",\"ts\":" << e.ts
+                    << ",\"pid\":1,\"tid\":" << e.tid
+                    << ",\"args\":{\"value\":" << e.value << "}}";
+            } else {
+                out << "{\"name\":\"" << e.name
+                    << "\",\"cat\":\"css\",\"ph\":\"X\",\"ts\":" << e.ts
+                    << ",\"dur\":" << e.value
+                    << ",\"pid\":1,\"tid\":" << e.tid << '}';
+            }
+        }
+
+        out << "\n]}\n";
+        return static_cast<bool>(out);
+#endif
+    }
+
+    static const char* counterName(Counter c) {
+        switch (c) {
+            case Counter::DeclarationsProcessed: return "declarations processed";
+            case Counter::AdapterAllocations:    return "adapter allocations";
+            case Counter::SfmlSetterCalls:       return "SFML setter calls";
+            case Counter::ParseFailures:         return "parse failures";
+            case Counter::UnknownProperties:     return "unknown properties";
+            default:                             return "?";
+        }
+    }
+
+private:
+    struct Event {
+        const char*   name      = nullptr;
+        Counter       counter   = Counter::Count_;
+        bool          isCounter = false;
+        std::int64_t  ts        = 0;
+        std::uint64_t value     = 0;    // duration (µs) for zones, sample for counters
+        std::uint64_t tid       = 0;
+    };
+
+    struct Storage {
+        std::mutex         mutex;
+        std::vector<Event> events;
+    };
+
+    using CounterArray =
+        std::array<std::atomic<std::uint64_t>, static_cast<std::size_t>(Counter::Count_)>;
+
+    static Storage& storage() {
+        static Storage s;
+        return s;
+    }
+
+    static CounterArray& counters() {
+        static CounterArray c{};
+        return c;
+    }
+
+    static int& depth() {
+        thread_local int d = 0;
+        return d;
+    }
+
+    static std::int64_t nowMicros() {
+        using namespace std::chrono;
+        return duration_cast<microseconds>(
+            steady_clock::now().time_since_epoch()).count();
+    }
+
+    static std::uint64_t threadId() {
+        return static_cast<std::uint64_t>(
+            std::hash<std::thread::id>{}(std::this_thread::get_id()) & 0xFFFFFFu);
+    }
+
+    static void record(const char* name, std::int64_t ts, std::int64_t dur, bool sampleCounters) {
+        const std::uint64_t tid = threadId();
+
+        std::lock_guard<std::mutex> lock(storage().mutex);
+        auto& events = storage().events;
+
+        Event zone;
+        zone.name  = name;
+        zone.ts    = ts;
+        zone.value = static_cast<std::uint64_t>(dur);
+        zone.tid   = tid;
+        events.push_back(zone);
+
+        if (!sampleCounters) return;
+
+        for (std::size_t i = 0; i < static_cast<std::size_t>(Counter::Count_); ++i) {
+            Event c;
+            c.counter   = static_cast<Counter>(i);
+            c.isCounter = true;
+            c.ts        = ts + dur;
+            c.value     = counters()[i].load(std::memory_order_relaxed);
+            c.tid       = tid;
+            events.push_back(c);
+        }
+    }
+};
+
+} // namespace utilities
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  Instrumentation macros — expand to nothing unless CSS_SFML_TRACE is defined
+// ─────────────────────────────────────────────────────────────────────────────
+#define CSS_TRACE_CONCAT_IMPL(a, b) a##b
+#define CSS_TRACE_CONCAT(a, b)      CSS_TRACE_CONCAT_IMPL(a, b)
+
+#if defined(CSS_SFML_TRACE)
+    #define CSS_TRACE_ZONE(name) \
+        ::utilities::Trace::Zone CSS_TRACE_CONCAT(cssTraceZone_, __LINE__){ name }
+    #define CSS_TRACE_COUNT(counter) \
+        ::utilities::Trace::count(::utilities::Trace::Counter::counter)
+    #define CSS_TRACE_COUNT_N(counter, n) \
+        ::utilities::Trace::count(::utilities::Trace::Counter::counter, \
+                                  static_cast<std::uint64_t>(n))
+#else
+    #define CSS_TRACE_ZONE(name)          ((void)0)
+    #define CSS_TRACE_COUNT(counter)      ((void)0)
+    #define CSS_TRACE_COUNT_N(counter, n) ((void)0)
+#endif
@@ -0,0 +1,55 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+
+namespace utilities {
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  TripleBuffer
+//
+//  Hands the latest value from one producer thread to one consumer thread
+//  without either waiting: the producer fills back() and publish()es it,
+//  the consumer fetch()es and reads front(). Three slots — the one being
+//  written, the one being read and the latest published one in between —
+//  so a publish never touches the slot being read. Publishing again before
+//  the consumer fetched replaces the value in between.
+//
+//  The slot in between and a "fresh" flag live in one atomic byte; swapping
+//  it is the only synchronisation (acquire/release).
+// ─────────────────────────────────────────────────────────────────────────────
+
+template<typename T>
+class TripleBuffer {
+public:
+    // Producer side
+    T& back() { return slots_[back_]; }
+
+    void publish() {
+        const std::uint8_t prev = middle_.exchange(static_cast<std::uint8_t>(back_ | kFresh),
+                                                   std::memory_order_acq_rel);
+        back_ = static_cast<std::uint8_t>(prev & kIndex);
+    }
+
+    // Consumer side: true when a newer value than front() was published
+    bool fetch() {
+        if (!(middle_.load(std::memory_order_relaxed) & kFresh)) return false;
+        const std::uint8_t prev = middle_.exchange(front_, std::memory_order_acq_rel);
+        front_ = static_cast<std::uint8_t>(prev & kIndex);
+        return true;
+    }
+
+    T& front() { return slots_[front_]; }
+
+    [[nodiscard]] bool fresh() const { return (middle_.load(std::memory_order_acquire) & kFresh) != 0; }
+
+private:
+    static constexpr std::uint8_t kIndex = 0x3;
+    static constexpr std::uint8_t kFresh = 0x4;
+
+    T                          slots_[3];
+    std::uint8_t               back_  = 0;      // producer only
+    std::uint8_t               front_ = 2;      // consumer only
+    std::atomic<std::uint8_t>  middle_{ 1 };
+};
+
+} // namespace utilities
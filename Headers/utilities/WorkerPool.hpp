@@ -0,0 +1,81 @@
+#pragma once
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace utilities {
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  WorkerPool
+//
+//  Fixed set of background threads draining a FIFO of jobs. Jobs must not
+//  touch SFML graphics state that needs the GL context (textures, windows)
+//  — decode on the pool, upload on the main thread.
+//
+//  The destructor finishes the queued jobs, then joins.
+// ─────────────────────────────────────────────────────────────────────────────
+
+class WorkerPool {
+public:
+    explicit WorkerPool(unsigned threads = defaultThreads()) {
+        threads = std::max(1u, threads);
+        workers_.reserve(threads);
+        for (unsigned i = 0; i < threads; ++i)
+            workers_.emplace_back([this] { run(); });
+    }
+
+    ~WorkerPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        wake_.notify_all();
+        for (auto& w : workers_) w.join();
+    }
+
+    WorkerPool(const WorkerPool&)            = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    void submit(std::function<void()> job) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            jobs_.push_back(std::move(job));
+        }
+        wake_.notify_one();
+    }
+
+    [[nodiscard]] std::size_t threads() const { return workers_.size(); }
+
+    // One thread short of the hardware, at most four
+    static unsigned defaultThreads() {
+        const unsigned hw = std::thread::hardware_concurrency();
+        return std::clamp(hw > 1 ? hw - 1 : 1u, 1u, 4u);
+    }
+
+private:
+    void run() {
+        for (;;) {
+            std::function<void()> job;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                wake_.wait(lock, [this] { return stopping_ || !jobs_.empty(); });
+                if (jobs_.empty()) return;
+                job = std::move(jobs_.front());
+                jobs_.pop_front();
+            }
+            job();
+        }
+    }
+
+    std::mutex                        mutex_;
+    std::condition_variable           wake_;
+    std::deque<std::function<void()>> jobs_;
+    bool                              stopping_ = false;
+    std::vector<std::thread>          workers_;
+};
+
+} // namespace utilities
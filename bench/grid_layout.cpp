@@ -0,0 +1,131 @@
+// ─────────────────────────────────────────────────────────────────────────────
+//  grid_layout — display: grid on a 100×100 grid
+//
+//  Times, for 10 000 cells in repeat(100, 1fr) columns and auto rows:
+//
+//    first       the container styled with all its children
+//    unchanged   the same Style() call again (cached track sizes)
+//    one cell    one cell grows taller, then the container is restyled
+//    append      one more cell, auto-placed on a new row
+//
+//  and checks every cell sits where the track arithmetic puts it.
+//
+//    g++ -std=c++17 -O2 bench/grid_layout.cpp -o grid_layout
+//        -lsfml-graphics -lsfml-window -lsfml-system
+//    ./grid_layout [repeats]
+//
+//  Exits non-zero if a cell is misplaced.
+// ─────────────────────────────────────────────────────────────────────────────
+
+#include <SFML/Graphics.hpp>
+#include "../Headers/CSS.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <string>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr int   kSide   = 100;
+constexpr float kWidth  = 1000.f;
+constexpr float kGap    = 1.f;
+constexpr float kCellH  = 5.f;
+
+const std::vector<std::string> kGrid = {
+    "left: 0px", "top: 0px", "width: 1000px", "height: auto",
+    "display: grid", "grid-template-columns: repeat(100, 1fr)",
+    "grid-auto-rows: auto", "gap: 1px", "align-items: start",
+};
+
+double ms(Clock::time_point a, Clock::time_point b) {
+    return std::chrono::duration<double, std::milli>(b - a).count();
+}
+
+double median(std::vector<double> v) {
+    std::sort(v.begin(), v.end());
+    return v[v.size() / 2];
+}
+
+// Row r starts below every earlier row; rows are as tall as their tallest cell
+std::size_t misplaced(const std::deque<sf::RectangleShape>& cells) {
+    const float column = (kWidth - (kSide - 1) * kGap) / kSide;
+    std::size_t wrong = 0;
+    float rowTop = 0.f;
+    for (std::size_t first = 0; first < cells.size(); first += kSide) {
+        float rowHeight = 0.f;
+        const std::size_t end = std::min(cells.size(), first + kSide);
+        for (std::size_t i = first; i < end; ++i) {
+            const sf::Vector2f p = cells[i].getPosition();
+            const float x = static_cast<float>(i - first) * (column + kGap);
+            if (std::abs(p.x - x) > 0.01f || std::abs(p.y - rowTop) > 0.01f) ++wrong;
+            rowHeight = std::max(rowHeight, cells[i].getSize().y);
+        }
+        rowTop += rowHeight + kGap;
+    }
+    return wrong;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const int repeats = argc > 1 ? std::atoi(argv[1]) : 5;
+
+    sf::RenderWindow window;
+    CSS::init(window);
+
+    std::vector<double> first, unchanged, oneCell, append;
+    std::size_t wrong = 0;
+    for (int r = 0; r < repeats; ++r) {
+        std::deque<sf::RectangleShape> cells(kSide * kSide);   // stable addresses on append
+        CSS::StyleableList list;
+        for (auto& c : cells) {
+            CSS::Style(c, { "width: 8px", "height: 5px" });
+            list.push_back(CSS::wrap(c));
+        }
+        sf::RectangleShape grid;
+
+        auto t0 = Clock::now();
+        CSS::Style(grid, kGrid, list);
+        auto t1 = Clock::now();
+        wrong += misplaced(cells);
+
+        CSS::Style(grid, kGrid, list);
+        auto t2 = Clock::now();
+
+        auto& tall = cells[kSide * kSide / 2 + 7];
+        CSS::Style(tall, { "height: " + std::to_string(kCellH * 3) + "px" });
+        CSS::Style(grid, kGrid, list);
+        auto t3 = Clock::now();
+        wrong += misplaced(cells);
+
+        cells.emplace_back();
+        CSS::Style(cells.back(), { "width: 8px", "height: 5px" });
+        list.push_back(CSS::wrap(cells.back()));
+        auto t4 = Clock::now();
+        CSS::Style(grid, kGrid, list);
+        auto t5 = Clock::now();
+        wrong += misplaced(cells);
+
+        first.push_back(ms(t0, t1));
+        unchanged.push_back(ms(t1, t2));
+        oneCell.push_back(ms(t2, t3));
+        append.push_back(ms(t4, t5));
+
+        for (auto& c : cells) CSS::forget(c);
+        CSS::forget(grid);
+    }
+
+    std::printf("100x100 grid, median of %d (ms)\n", repeats);
+    std::printf("  first      %8.3f\n", median(first));
+    std::printf("  unchanged  %8.3f\n", median(unchanged));
+    std::printf("  one cell   %8.3f\n", median(oneCell));
+    std::printf("  append     %8.3f\n", median(append));
+    if (wrong) std::printf("  %zu misplaced cells\n", wrong);
+    return wrong ? 1 : 0;
+}
@@ -0,0 +1,127 @@
+// ─────────────────────────────────────────────────────────────────────────────
+//  hit_test — CSS::hitTest / CSS::query latency against element count
+//
+//  Styles N rectangles (some rotated or scaled, all overlapping heavily),
+//  then picks random points and queries random rects through the spatial
+//  index and by brute force over every element, checks both agree and
+//  prints the time per call.
+//
+//    g++ -std=c++17 -O2 bench/hit_test.cpp -o hit_test
+//        -lsfml-graphics -lsfml-window -lsfml-system
+//    ./hit_test [picks]
+//
+//  Exits non-zero if the index and the brute force disagree.
+// ─────────────────────────────────────────────────────────────────────────────
+
+#include <SFML/Graphics.hpp>
+#include "../Headers/CSS.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double nsPer(Clock::time_point a, Clock::time_point b, std::size_t n) {
+    return std::chrono::duration<double, std::nano>(b - a).count() / static_cast<double>(n);
+}
+
+std::string px(float v) { return std::to_string(v) + "px"; }
+
+// Topmost first: nothing uses z-index here, so paint order is styling order
+const void* bruteHit(const std::vector<sf::RectangleShape>& shapes, sf::Vector2f p) {
+    for (std::size_t i = shapes.size(); i-- > 0;) {
+        const sf::Vector2f local = shapes[i].getInverseTransform().transformPoint(p);
+        if (shapes[i].getLocalBounds().contains(local)) return &shapes[i];
+    }
+    return nullptr;
+}
+
+// The registry's test — world bounds, then the area in the shape's local
+// space, both half-open — run on every element instead of the index's
+// candidates
+bool bruteOverlaps(const sf::RectangleShape& s, const sf::FloatRect& area) {
+    return core::SpatialIndex::overlaps(s.getGlobalBounds(), area)
+        && core::SpatialIndex::overlaps(s.getInverseTransform().transformRect(area), s.getLocalBounds());
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::size_t picks = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 20000;
+    const sf::Vector2f world{ 4000.f, 3000.f };
+
+    sf::RenderWindow window;
+    CSS::init(window);
+
+    std::printf("%8s %14s %14s %14s %14s\n", "elements", "hitTest ns", "brute ns", "query ns", "brute ns");
+    bool agree = true;
+    for (std::size_t n : { 1000u, 5000u, 20000u, 50000u }) {
+        std::mt19937 rng(static_cast<unsigned>(n));
+        std::uniform_real_distribution<float> x(0.f, world.x), y(0.f, world.y), side(4.f, 120.f), angle(0.f, 360.f);
+
+        std::vector<sf::RectangleShape> shapes(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            std::vector<std::string> rules = {
+                "left: " + px(x(rng)), "top: " + px(y(rng)),
+                "width: " + px(side(rng)), "height: " + px(side(rng)),
+            };
+            if (i % 4 == 1) rules.push_back("rotation: " + std::to_string(angle(rng)));
+            if (i % 8 == 2) rules.push_back("scale: 1.5 0.75");
+            CSS::Style(shapes[i], rules);
+        }
+
+        std::vector<sf::Vector2f> points(picks);
+        for (auto& p : points) p = { x(rng), y(rng) };
+        std::vector<sf::FloatRect> areas(picks / 10 + 1);
+        for (auto& a : areas) a = { { x(rng), y(rng) }, { side(rng), side(rng) } };
+
+        // Index
+        std::size_t found = 0;
+        auto t0 = Clock::now();
+        for (const auto& p : points) found += CSS::hitTest(p).valid();
+        auto t1 = Clock::now();
+        std::size_t queried = 0;
+        for (const auto& a : areas) queried += CSS::query(a).size();
+        auto t2 = Clock::now();
+
+        // Brute force
+        std::size_t bruteFound = 0;
+        for (const auto& p : points) bruteFound += bruteHit(shapes, p) != nullptr;
+        auto t3 = Clock::now();
+        std::size_t bruteQueried = 0;
+        for (const auto& a : areas)
+            for (const auto& s : shapes) bruteQueried += bruteOverlaps(s, a);
+        auto t4 = Clock::now();
+
+        std::printf("%8zu %14.1f %14.1f %14.1f %14.1f\n", n,
+                    nsPer(t0, t1, points.size()), nsPer(t2, t3, points.size()),
+                    nsPer(t1, t2, areas.size()),  nsPer(t3, t4, areas.size()));
+
+        // Same answers, element by element
+        std::size_t wrong = (found != bruteFound) + (queried != bruteQueried);
+        for (const auto& p : points) {
+            const CSS::Styleable hit = CSS::hitTest(p);
+            wrong += (hit.valid() ? hit->native() : nullptr) != bruteHit(shapes, p);
+        }
+        for (const auto& a : areas) {
+            std::vector<const void*> index, brute;
+            for (const auto& el : CSS::query(a)) index.push_back(el->native());
+            for (const auto& s : shapes)
+                if (bruteOverlaps(s, a)) brute.push_back(&s);
+            wrong += index != brute;
+        }
+        if (wrong) {
+            std::printf("  %zu mismatches against brute force\n", wrong);
+            agree = false;
+        }
+
+        for (auto& s : shapes) CSS::forget(s);
+    }
+    return agree ? 0 : 1;
+}
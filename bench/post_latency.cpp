@@ -0,0 +1,173 @@
+// ─────────────────────────────────────────────────────────────────────────────
+//  post_latency — CSS::post producer latency under contention
+//
+//  1, 2, 4 … producer threads (up to the hardware's, at least 4) post
+//  color changes to their own elements as fast as they can while the main
+//  thread drains with CSS::applyPosted() once per "frame". Prints, per
+//  producer count, the latency of each post() call and how often the ring
+//  was full, for both entry points:
+//
+//    rule          CSS::post(element, "background-color: …")   parse + push
+//    declaration   PostQueue::post(handle, Declaration)         push only
+//
+//  then checks every element ended up with the last color its producer
+//  managed to post.
+//
+//    g++ -std=c++17 -O2 -pthread bench/post_latency.cpp -o post_latency
+//        -lsfml-graphics -lsfml-window -lsfml-system
+//    ./post_latency [milliseconds per run] [frame microseconds]
+//
+//  Latencies include one steady_clock read. With fewer hardware threads
+//  than producers plus the render thread they time-share a core, which
+//  shows scheduling rather than contention. Exits non-zero if a final
+//  color is wrong.
+// ─────────────────────────────────────────────────────────────────────────────
+
+#include <SFML/Graphics.hpp>
+#include "../Headers/CSS.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr std::size_t kElementsPerProducer = 8;
+constexpr std::size_t kSamplesPerProducer  = 1u << 20;
+
+const char* kHex = "0123456789abcdef";
+
+std::string color(unsigned r) {
+    return std::string("#") + kHex[r >> 4] + kHex[r & 15] + "0000";
+}
+
+struct Producer {
+    std::vector<sf::RectangleShape> elements{ kElementsPerProducer };
+    std::array<int, kElementsPerProducer> last{};   // red of the last accepted post, -1 none
+    std::vector<float> samples;                     // ns per accepted post
+    std::size_t accepted = 0, full = 0;
+};
+
+struct Result {
+    std::vector<float> samples;
+    std::size_t accepted = 0, full = 0, frames = 0, wrong = 0;
+};
+
+template<typename Post>
+void produce(Producer& p, const std::atomic<bool>& go, const std::atomic<bool>& stop, Post&& post) {
+    p.samples.clear();
+    p.samples.reserve(kSamplesPerProducer);
+    p.last.fill(-1);
+    while (!go.load(std::memory_order_acquire)) std::this_thread::yield();
+    for (unsigned i = 0; !stop.load(std::memory_order_relaxed); ++i) {
+        const std::size_t e = i % kElementsPerProducer;
+        const unsigned    r = (i / kElementsPerProducer) & 255;
+        const auto t0 = Clock::now();
+        const bool ok = post(p.elements[e], r);
+        const auto t1 = Clock::now();
+        if (!ok) { ++p.full; continue; }
+        ++p.accepted;
+        p.last[e] = static_cast<int>(r);
+        if (p.samples.size() < kSamplesPerProducer)
+            p.samples.push_back(std::chrono::duration<float, std::nano>(t1 - t0).count());
+    }
+}
+
+template<typename Post>
+Result run(std::vector<Producer>& producers, std::chrono::milliseconds length,
+           std::chrono::microseconds frame, Post post) {
+    std::atomic<bool> go{ false }, stop{ false };
+    std::vector<std::thread> threads;
+    for (auto& p : producers) {
+        p.accepted = p.full = 0;
+        threads.emplace_back([&p, &go, &stop, post] { produce(p, go, stop, post); });
+    }
+
+    Result r;
+    go.store(true, std::memory_order_release);
+    const auto start = Clock::now();
+    while (Clock::now() - start < length) {
+        CSS::applyPosted();
+        ++r.frames;
+        std::this_thread::sleep_for(frame);
+    }
+    stop = true;
+    for (auto& t : threads) t.join();
+    while (CSS::applyPosted() > 0) {}
+
+    for (auto& p : producers) {
+        r.samples.insert(r.samples.end(), p.samples.begin(), p.samples.end());
+        r.accepted += p.accepted;
+        r.full     += p.full;
+        for (std::size_t e = 0; e < kElementsPerProducer; ++e)
+            if (p.last[e] >= 0 && p.elements[e].getFillColor().r != p.last[e]) ++r.wrong;
+    }
+    return r;
+}
+
+void report(const char* mode, std::size_t producers, Result& r, std::chrono::milliseconds length) {
+    std::sort(r.samples.begin(), r.samples.end());
+    auto at = [&](double q) {
+        return r.samples.empty() ? 0.f : r.samples[static_cast<std::size_t>(q * static_cast<double>(r.samples.size() - 1))];
+    };
+    const double total = static_cast<double>(r.accepted + r.full);
+    std::printf("%-12s %9zu %9.1f %9.1f %9.1f %9.1f %10.2f %8.1f%%\n", mode, producers,
+                at(0.5), at(0.99), at(0.999), r.samples.empty() ? 0.f : r.samples.back(),
+                static_cast<double>(r.accepted) / static_cast<double>(length.count()) / 1e3,
+                total > 0 ? 100.0 * static_cast<double>(r.full) / total : 0.0);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::chrono::milliseconds   length{ argc > 1 ? std::atoi(argv[1]) : 1000 };
+    const std::chrono::microseconds   frame { argc > 2 ? std::atoi(argv[2]) : 1000 };
+    const std::size_t hardware = std::max(1u, std::thread::hardware_concurrency());
+    const std::size_t most     = std::max<std::size_t>(4, hardware);
+
+    sf::RenderWindow window;
+    CSS::init(window);
+
+    std::vector<std::string> rules(256);
+    std::vector<contracts::Declaration> decls(256);
+    for (unsigned r = 0; r < 256; ++r) {
+        rules[r] = "background-color: " + color(r);
+        decls[r] = { "background-color", color(r) };
+    }
+
+    std::printf("%zu hardware threads, %lld ms per run, applyPosted every %lld us, ring of %zu\n",
+                hardware, static_cast<long long>(length.count()),
+                static_cast<long long>(frame.count()), core::PostQueue::kCapacity);
+    std::printf("%-12s %9s %9s %9s %9s %9s %10s %9s\n",
+                "entry", "producers", "p50 ns", "p99 ns", "p99.9 ns", "max ns", "Mposts/s", "full");
+
+    std::size_t wrong = 0;
+    for (std::size_t n = 1; n <= most; n *= 2) {
+        std::vector<Producer> producers(n);
+        for (auto& p : producers)
+            for (auto& e : p.elements) CSS::Style(e, { "width: 10px", "height: 10px", "background-color: #000000" });
+
+        Result byRule = run(producers, length, frame, [&rules](sf::RectangleShape& e, unsigned r) {
+            return CSS::post(e, rules[r]);
+        });
+        report("rule", n, byRule, length);
+
+        Result byDecl = run(producers, length, frame, [&decls](sf::RectangleShape& e, unsigned r) {
+            return core::PostQueue::post(CSS::wrap(e), decls[r]);
+        });
+        report("declaration", n, byDecl, length);
+
+        wrong += byRule.wrong + byDecl.wrong;
+        for (auto& p : producers)
+            for (auto& e : p.elements) CSS::forget(e);
+    }
+    if (wrong) std::printf("%zu elements missed their last posted color\n", wrong);
+    return wrong ? 1 : 0;
+}
@@ -0,0 +1,171 @@
+// ─────────────────────────────────────────────────────────────────────────────
+//  relayout — laying a container out again leaves its children in place
+//
+//  A container is laid out again whenever something it depends on changes
+//  after its Style() call. Each check below triggers that, several times,
+//  on a padded container without flex or grid, and requires every child
+//  to end up where the first layout put it.
+//
+//    g++ -std=c++17 -O2 tests/relayout.cpp -o relayout
+//        -lsfml-graphics -lsfml-window -lsfml-system
+//    ./relayout
+//
+//  Prints each failing check and exits non-zero if there is one.
+// ─────────────────────────────────────────────────────────────────────────────
+
+#include <SFML/Graphics.hpp>
+#include "../Headers/CSS.hpp"
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+int failures = 0;
+
+void expect(bool ok, const char* check, const std::string& detail) {
+    if (ok) return;
+    ++failures;
+    std::printf("FAIL %s: %s\n", check, detail.c_str());
+}
+
+std::string str(sf::Vector2f v) {
+    return "(" + std::to_string(v.x) + ", " + std::to_string(v.y) + ")";
+}
+
+// Runs `again` `times` times and requires `child` to stay at `expected`
+void stays(const char* check, const sf::Transformable& child, sf::Vector2f expected,
+           const std::function<void()>& again, int times = 3) {
+    for (int i = 0; i < times; ++i) {
+        again();
+        expect(child.getPosition() == expected, check,
+               "pass " + std::to_string(i + 1) + " moved the child to " + str(child.getPosition())
+               + ", expected " + str(expected));
+    }
+}
+
+// :hover with a geometry override restyles the child and its container
+void stateToggle() {
+    sf::RectangleShape card, btn;
+    CSS::Style(btn, { "width: 80px", "height: 20px", ":hover { width: 120px }" });
+    CSS::Style(card, { "left: 100px", "top: 100px", "width: 300px", "height: 200px", "padding: 10px" },
+               CSS::StyleableList{ CSS::wrap(btn) });
+    expect(btn.getPosition() == sf::Vector2f(110.f, 110.f), "state toggle",
+           "first layout put the child at " + str(btn.getPosition()));
+
+    stays("state toggle", btn, { 110.f, 110.f }, [&] {
+        CSS::setState(btn, CSS::State::Hover, true);
+        expect(btn.getSize().x == 120.f, "state toggle", "hover didn't apply");
+        CSS::setState(btn, CSS::State::Hover, false);
+    }, 2);
+
+    CSS::forget(btn);
+    CSS::forget(card);
+}
+
+// A var() in a geometry declaration restyles the container on setVar
+void variableChange() {
+    sf::RectangleShape card, bar;
+    CSS::setVar("--w", "40px");
+    CSS::Style(bar, { "width: var(--w)", "height: 10px" });
+    CSS::Style(card, { "left: 50px", "top: 0px", "width: 200px", "height: 100px", "padding: 5px" },
+               CSS::StyleableList{ CSS::wrap(bar) });
+    const sf::Vector2f at = bar.getPosition();
+    expect(at == sf::Vector2f(55.f, 5.f), "setVar", "first layout put the child at " + str(at));
+
+    int width = 40;
+    stays("setVar", bar, at, [&] {
+        width += 10;
+        CSS::setVar("--w", std::to_string(width) + "px");
+        expect(bar.getSize().x == static_cast<float>(width), "setVar", "the new width didn't apply");
+    });
+
+    CSS::forget(bar);
+    CSS::forget(card);
+}
+
+// A content-sized container is laid out again when a child's size changes
+void contentSized() {
+    sf::RectangleShape box, a, b;
+    CSS::Style(a, { "left: 0px", "top: 0px", "width: 30px", "height: 10px" });
+    CSS::Style(b, { "left: 40px", "top: 0px", "width: 30px", "height: 10px" });
+    CSS::Style(box, { "left: 20px", "top: 20px", "width: auto", "height: auto", "padding: 8px" },
+               CSS::StyleableList{ CSS::wrap(a), CSS::wrap(b) });
+    const sf::Vector2f at = b.getPosition();
+    expect(at == sf::Vector2f(68.f, 28.f), "auto", "first layout put the child at " + str(at));
+
+    int height = 10;
+    stays("auto", b, at, [&] {
+        height += 5;
+        CSS::Style(a, { "height: " + std::to_string(height) + "px" });
+        expect(box.getSize().y == static_cast<float>(height + 16), "auto",
+               "the container is " + str(box.getSize()) + " around a " + std::to_string(height) + "px child");
+    });
+    expect(a.getPosition() == sf::Vector2f(28.f, 28.f), "auto",
+           "the resized child moved to " + str(a.getPosition()));
+
+    CSS::forget(a);
+    CSS::forget(b);
+    CSS::forget(box);
+}
+
+// A natural-size sprite resizes when its image arrives, which lays its
+// container out again; here twice, once per image
+void imagesArrive() {
+    const std::filesystem::path dir = std::filesystem::temp_directory_path();
+    const std::string first  = (dir / "relayout_first.bmp").string();
+    const std::string second = (dir / "relayout_second.bmp").string();
+    if (!sf::Image({ 24, 16 }, sf::Color::Red).saveToFile(first)
+        || !sf::Image({ 32, 12 }, sf::Color::Blue).saveToFile(second)) {
+        expect(false, "images", "couldn't write the test images to " + dir.string());
+        return;
+    }
+
+    sf::Texture placeholder;
+    sf::Sprite a(placeholder, { { 0, 0 }, { 4, 4 } }), b(placeholder, { { 0, 0 }, { 4, 4 } });
+    CSS::Style(a, { "left: 0px", "top: 0px", "background-image: url(" + first + ")" });
+    CSS::Style(b, { "left: 50px", "top: 0px", "background-image: url(" + second + ")" });
+    sf::RectangleShape card;
+    CSS::Style(card, { "left: 100px", "top: 100px", "width: 300px", "height: 100px", "padding: 10px" },
+               CSS::StyleableList{ CSS::wrap(a), CSS::wrap(b) });
+    expect(b.getPosition() == sf::Vector2f(160.f, 110.f), "images",
+           "first layout put the child at " + str(b.getPosition()));
+
+    std::size_t arrived = 0;
+    const auto start = std::chrono::steady_clock::now();
+    while (arrived < 2 && std::chrono::steady_clock::now() - start < std::chrono::seconds(5)) {
+        arrived += CSS::pumpUploads();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    expect(arrived == 2, "images", std::to_string(arrived) + " of 2 images arrived");
+    expect(a.getGlobalBounds().size != sf::Vector2f(4.f, 4.f), "images", "the first sprite kept its placeholder size");
+    expect(a.getPosition() == sf::Vector2f(110.f, 110.f), "images",
+           "the first sprite moved to " + str(a.getPosition()));
+    expect(b.getPosition() == sf::Vector2f(160.f, 110.f), "images",
+           "the second sprite moved to " + str(b.getPosition()));
+
+    CSS::forget(a);
+    CSS::forget(b);
+    CSS::forget(card);
+    std::filesystem::remove(first);
+    std::filesystem::remove(second);
+}
+
+} // namespace
+
+int main() {
+    sf::RenderWindow window;
+    CSS::init(window);
+
+    stateToggle();
+    variableChange();
+    contentSized();
+    imagesArrive();
+
+    if (!failures) std::printf("all relayout checks passed\n");
+    return failures ? 1 : 0;
+}